@@ -0,0 +1,143 @@
+#pragma once
+
+#include "filters.h"
+
+
+/*!
+Cascade of `Stages` biquad filters (second order sections) run as a single filter.
+
+All the section coefficients are held contiguously, as `biquad_coefficients_t`, as are all the section states, and the whole cascade is run in one call.
+The coefficients of a section can be taken from a `BiquadFilter`, see `set_parameters(stage, filter)`, `init_lowpass()` and `init_notch()`.
+
+Each section is implemented using the modified transposed direct form II of `BiquadFilter::filter_block()`, so the recursive path of each section is a single
+multiply and subtract, and the output of one section is passed directly to the next in a register.
+The sections are independent recursions, so the processor overlaps the sections of successive samples, and the cost per sample is less than that of
+running each `BiquadFilter` in turn, either a sample or a block at a time.
+
+Each section has a weight, used by `filter_weighted()`, which gives the same result as chaining `BiquadFilter::filter_weighted()` calls.
+
+Note: because the section state is held in transposed direct form II, changing the coefficients while the filter is running gives slightly
+different transients than `BiquadFilter`. For swept filters use `BiquadFilter` or `BiquadFilterBank`.
+*/
+template <size_t Stages>
+class BiquadCascade : public FilterBase {
+public:
+    struct state_t {
+        float s1; //!< held without its `-a1*y1` term, see `BiquadFilter::filter_block()`
+        float s2;
+        float y1;
+    };
+public:
+    BiquadCascade() { set_to_passthrough(); }
+    //! Construct from a set of section coefficients, for example as designed at compile time by `FilterDesign`.
+    explicit BiquadCascade(const std::array<biquad_coefficients_t, Stages>& coefficients) { set_parameters(coefficients); reset(); }
+    static constexpr size_t stage_count() { return Stages; }
+
+    void set_weight(size_t stage, float weight) { _weights[stage] = weight; }
+    float get_weight(size_t stage) const { return _weights[stage]; }
+    void set_parameters(size_t stage, const biquad_coefficients_t& coefficients, float weight) { _coefficients[stage] = coefficients; _weights[stage] = weight; }
+    void set_parameters(size_t stage, const biquad_coefficients_t& coefficients) { set_parameters(stage, coefficients, 1.0F); }
+    void set_parameters(size_t stage, float a1, float a2, float b0, float b1, float b2) { set_parameters(stage, biquad_coefficients_t { a1, a2, b0, b1, b2 }); }
+    //! Sets the coefficients and weight of `stage` to those of `filter`.
+    void set_parameters(size_t stage, const BiquadFilter& filter) { set_parameters(stage, filter.get_parameters(), filter.get_weight()); }
+    void set_parameters(const std::array<biquad_coefficients_t, Stages>& coefficients) {
+        for (size_t ii = 0; ii < Stages; ++ii) {
+            set_parameters(ii, coefficients[ii]);
+        }
+    }
+    const biquad_coefficients_t& get_parameters(size_t stage) const { return _coefficients[stage]; }
+
+    void reset() { _state.fill(state_t{}); }
+    void set_to_passthrough() { _coefficients.fill(biquad_coefficients_t { 0.0F, 0.0F, 1.0F, 0.0F, 0.0F }); _weights.fill(1.0F); reset(); }
+
+    float filter(float input) { return step<false>(input, _coefficients, _weights, _state); }
+    //! Applies the weight of each stage to that stage, so each stage combines its own input and output.
+    float filter_weighted(float input) { return step<true>(input, _coefficients, _weights, _state); }
+    virtual float filter_virtual(float input) override { return filter(input); }
+
+    void filter_block(const float* input, float* output, size_t count) { run_block<false>(input, output, count); }
+    void filter_block(float* data, size_t count) { run_block<false>(data, data, count); } //!< in-place variant
+    void filter_weighted_block(const float* input, float* output, size_t count) { run_block<true>(input, output, count); }
+    void filter_weighted_block(float* data, size_t count) { run_block<true>(data, data, count); } //!< in-place variant
+
+    void init_lowpass(size_t stage, float frequency_hz, float looptime_seconds, float q);
+    void init_notch(size_t stage, float frequency_hz, float looptime_seconds, float q);
+// for testing
+    const std::array<state_t, Stages>& get_state() const { return _state; }
+private:
+    template <bool WEIGHTED, size_t STAGE = 0>
+    static float step(float input, const std::array<biquad_coefficients_t, Stages>& coefficients, const std::array<float, Stages>& weights, std::array<state_t, Stages>& state);
+    template <bool WEIGHTED>
+    void run_block(const float* input, float* output, size_t count);
+protected:
+    std::array<biquad_coefficients_t, Stages> _coefficients {};
+    std::array<float, Stages> _weights {};
+    std::array<state_t, Stages> _state {};
+};
+
+/*!
+Runs the input through section `STAGE` and then through the following sections.
+
+The sections are unrolled at compile time, so that in `filter_block()` each section state has a constant index into the local state array
+and so can be held in registers, rather than stored and reloaded on every sample.
+*/
+template <size_t Stages>
+template <bool WEIGHTED, size_t STAGE>
+inline float BiquadCascade<Stages>::step(float input, const std::array<biquad_coefficients_t, Stages>& coefficients, const std::array<float, Stages>& weights, std::array<state_t, Stages>& state)
+{
+    const biquad_coefficients_t& c = coefficients[STAGE];
+    state_t& s = state[STAGE];
+    const float y = input*c.b0 + s.s1 - s.y1*c.a1;
+    s.s1 = s.s2 + input*c.b1;
+    s.s2 = input*c.b2 - y*c.a2;
+    s.y1 = y;
+    // weight of 1.0 gives just output, weight of 0.0 gives just input
+    const float output = WEIGHTED ? (y - input)*weights[STAGE] + input : y;
+    if constexpr (STAGE + 1 < Stages) {
+        return step<WEIGHTED, STAGE + 1>(output, coefficients, weights, state);
+    } else {
+        return output;
+    }
+}
+
+/*!
+Filters `count` samples from `input` into `output`, `input` and `output` may be the same buffer.
+
+The coefficients, weights and state are copied into local arrays for the duration of the block, so that they can be held in registers.
+*/
+template <size_t Stages>
+template <bool WEIGHTED>
+void BiquadCascade<Stages>::run_block(const float* input, float* output, size_t count)
+{
+    const std::array<biquad_coefficients_t, Stages> coefficients = _coefficients;
+    const std::array<float, Stages> weights = _weights;
+    std::array<state_t, Stages> state = _state;
+    for (size_t ii = 0; ii < count; ++ii) {
+        output[ii] = step<WEIGHTED>(input[ii], coefficients, weights, state);
+    }
+    _state = state;
+}
+
+/*!
+Sets the coefficients of a single stage to those of `BiquadFilter::init_lowpass` and resets that stage.
+*/
+template <size_t Stages>
+inline void BiquadCascade<Stages>::init_lowpass(size_t stage, float frequency_hz, float looptime_seconds, float q)
+{
+    BiquadFilter filter;
+    filter.init_lowpass(frequency_hz, looptime_seconds, q);
+    set_parameters(stage, filter.get_parameters());
+    _state[stage] = state_t{};
+}
+
+/*!
+Sets the coefficients of a single stage to those of `BiquadFilter::init_notch` and resets that stage.
+*/
+template <size_t Stages>
+inline void BiquadCascade<Stages>::init_notch(size_t stage, float frequency_hz, float looptime_seconds, float q)
+{
+    BiquadFilter filter;
+    filter.init_notch(frequency_hz, looptime_seconds, q);
+    set_parameters(stage, filter.get_parameters());
+    _state[stage] = state_t{};
+}
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "filter_simd.h"
+#include "filter_trig.h"
+
+
+/*!
+Bank of N independent biquad filters, stored as structure-of-arrays so that all the lanes can be stepped together.
+
+Each lane has the same semantics as a `BiquadFilter`: `init_lowpass`, `init_notch`, `set_notch_frequency_weighted` etc take
+the lane index as their first parameter, but otherwise behave identically, so an array of `BiquadFilter` can be replaced without retuning.
+
+Each lane uses the same direct form I state as `BiquadFilter`, so lanes respond identically when their coefficients are changed while running.
+Lanes are processed 8 at a time using AVX, 4 at a time using SSE, with a scalar loop for the remainder and for targets without SIMD.
+Define `LIBRARY_FILTER_NO_SIMD` to force the scalar implementation.
+*/
+template <size_t N>
+class BiquadFilterBank {
+public:
+    BiquadFilterBank() {
+        for (size_t ii = 0; ii < N; ++ii) {
+            set_to_passthrough(ii);
+        }
+    }
+public:
+    static constexpr size_t size() { return N; }
+
+    void set_weight(size_t lane, float weight) { _weight[lane] = weight; }
+    float get_weight(size_t lane) const { return _weight[lane]; }
+    void set_parameters(size_t lane, float a1, float a2, float b0, float b1, float b2, float weight) {
+        _weight[lane] = weight;
+        _a1[lane] = a1;
+        _a2[lane] = a2;
+        _b0[lane] = b0;
+        _b1[lane] = b1;
+        _b2[lane] = b2;
+    }
+    void set_parameters(size_t lane, float a1, float a2, float b0, float b1, float b2) {
+        set_parameters(lane, a1, a2, b0, b1, b2, 1.0F);
+    }
+
+    void reset() { _x1.fill(0.0F); _x2.fill(0.0F); _y1.fill(0.0F); _y2.fill(0.0F); }
+    void reset(size_t lane) { _x1[lane] = 0.0F; _x2[lane] = 0.0F; _y1[lane] = 0.0F; _y2[lane] = 0.0F; }
+    void set_to_passthrough(size_t lane) { set_parameters(lane, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 1.0F); reset(lane); }
+
+    //! Filters one sample on each of the N lanes, `input` and `output` may be the same array.
+    void filter(const float* input, float* output) { step<false>(input, output); }
+    //! Weighted filter of one sample on each of the N lanes, weight of 1.0 gives just output, weight of 0.0 gives just input.
+    void filter_weighted(const float* input, float* output) { step<true>(input, output); }
+    void filter(const std::array<float, N>& input, std::array<float, N>& output) { step<false>(&input[0], &output[0]); }
+    void filter_weighted(const std::array<float, N>& input, std::array<float, N>& output) { step<true>(&input[0], &output[0]); }
+
+    void init_lowpass(size_t lane, float frequency_hz, float looptime_seconds, float q) {
+        assert(q != 0.0F && "q cannot be zero");
+        set_looptime(lane, looptime_seconds);
+        set_q(lane, q);
+        set_low_pass_frequency(lane, frequency_hz);
+        reset(lane);
+    }
+    void init_notch(size_t lane, float frequency_hz, float looptime_seconds, float q) {
+        assert(q != 0.0F && "q cannot be zero");
+        set_looptime(lane, looptime_seconds);
+        set_q(lane, q);
+        set_notch_frequency(lane, frequency_hz);
+        reset(lane);
+    }
+
+    float calculate_omega(size_t lane, float frequency) const { return frequency*_2_pi_looptime_seconds[lane]; }
+
+    void set_low_pass_frequencyWeighted(size_t lane, float frequency_hz, float weight);
+    void set_low_pass_frequency(size_t lane, float frequency_hz) { set_low_pass_frequencyWeighted(lane, frequency_hz, 1.0F); }
+
+    void set_notch_frequency_weighted(size_t lane, float frequency_hz, float weight); // assumes q already set
+    void set_notch_frequency(size_t lane, float frequency_hz) { set_notch_frequency_weighted(lane, frequency_hz, 1.0F); } // assumes q already set
+    void set_notch_frequency_weighted(size_t lane, float sin_omega, float two_cos_omega, float weight);
+
+    static float calculate_q(float center_frequency_hz, float lower_cutoff_frequency_hz) {
+        return center_frequency_hz*lower_cutoff_frequency_hz/(center_frequency_hz*center_frequency_hz - lower_cutoff_frequency_hz*lower_cutoff_frequency_hz);
+    }
+    void set_q(size_t lane, float q) { _2q_reciprocal[lane] = 1.0F /(2.0F*q); }
+    float get_q(size_t lane) const { return (1.0F/_2q_reciprocal[lane])/2.0F; }
+
+    void set_looptime(size_t lane, float looptime_seconds) { _2_pi_looptime_seconds[lane] = 2.0F*PI_F*looptime_seconds; }
+private:
+    template <bool WEIGHTED>
+    void step(const float* input, float* output);
+protected:
+    alignas(32) std::array<float, N> _weight {};
+    alignas(32) std::array<float, N> _a1 {};
+    alignas(32) std::array<float, N> _a2 {};
+    alignas(32) std::array<float, N> _b0 {};
+    alignas(32) std::array<float, N> _b1 {};
+    alignas(32) std::array<float, N> _b2 {};
+    alignas(32) std::array<float, N> _x1 {};
+    alignas(32) std::array<float, N> _x2 {};
+    alignas(32) std::array<float, N> _y1 {};
+    alignas(32) std::array<float, N> _y2 {};
+
+    std::array<float, N> _2q_reciprocal {};
+    std::array<float, N> _2_pi_looptime_seconds {};
+protected:
+    static constexpr float PI_F = 3.14159265358979323846F;
+};
+
+template <size_t N>
+template <bool WEIGHTED>
+void BiquadFilterBank<N>::step(const float* input, float* output)
+{
+#if defined(LIBRARY_FILTER_SIMD_AVX)
+    constexpr size_t AVX_END = N - N % 8;
+    constexpr size_t SSE_END = N - N % 4;
+#elif defined(LIBRARY_FILTER_SIMD_SSE)
+    constexpr size_t AVX_END = 0;
+    constexpr size_t SSE_END = N - N % 4;
+#else
+    constexpr size_t SSE_END = 0;
+#endif
+#if defined(LIBRARY_FILTER_SIMD_AVX)
+    for (size_t ii = 0; ii < AVX_END; ii += 8) {
+        const __m256 x = _mm256_loadu_ps(input + ii);
+        const __m256 x1 = _mm256_loadu_ps(&_x1[ii]);
+        const __m256 y1 = _mm256_loadu_ps(&_y1[ii]);
+        __m256 y = _mm256_mul_ps(x, _mm256_loadu_ps(&_b0[ii]));
+        y = _mm256_add_ps(y, _mm256_mul_ps(x1, _mm256_loadu_ps(&_b1[ii])));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(&_x2[ii]), _mm256_loadu_ps(&_b2[ii])));
+        y = _mm256_sub_ps(y, _mm256_mul_ps(y1, _mm256_loadu_ps(&_a1[ii])));
+        y = _mm256_sub_ps(y, _mm256_mul_ps(_mm256_loadu_ps(&_y2[ii]), _mm256_loadu_ps(&_a2[ii])));
+        _mm256_storeu_ps(&_x2[ii], x1);
+        _mm256_storeu_ps(&_x1[ii], x);
+        _mm256_storeu_ps(&_y2[ii], y1);
+        _mm256_storeu_ps(&_y1[ii], y);
+        if constexpr (WEIGHTED) {
+            _mm256_storeu_ps(output + ii, _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(y, x), _mm256_loadu_ps(&_weight[ii])), x));
+        } else {
+            _mm256_storeu_ps(output + ii, y);
+        }
+    }
+#endif
+#if defined(LIBRARY_FILTER_SIMD_SSE)
+    for (size_t ii = AVX_END; ii < SSE_END; ii += 4) {
+        const __m128 x = _mm_loadu_ps(input + ii);
+        const __m128 x1 = _mm_loadu_ps(&_x1[ii]);
+        const __m128 y1 = _mm_loadu_ps(&_y1[ii]);
+        __m128 y = _mm_mul_ps(x, _mm_loadu_ps(&_b0[ii]));
+        y = _mm_add_ps(y, _mm_mul_ps(x1, _mm_loadu_ps(&_b1[ii])));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&_x2[ii]), _mm_loadu_ps(&_b2[ii])));
+        y = _mm_sub_ps(y, _mm_mul_ps(y1, _mm_loadu_ps(&_a1[ii])));
+        y = _mm_sub_ps(y, _mm_mul_ps(_mm_loadu_ps(&_y2[ii]), _mm_loadu_ps(&_a2[ii])));
+        _mm_storeu_ps(&_x2[ii], x1);
+        _mm_storeu_ps(&_x1[ii], x);
+        _mm_storeu_ps(&_y2[ii], y1);
+        _mm_storeu_ps(&_y1[ii], y);
+        if constexpr (WEIGHTED) {
+            _mm_storeu_ps(output + ii, _mm_add_ps(_mm_mul_ps(_mm_sub_ps(y, x), _mm_loadu_ps(&_weight[ii])), x));
+        } else {
+            _mm_storeu_ps(output + ii, y);
+        }
+    }
+#endif
+    // scalar loop, written over the arrays so the compiler may vectorize it on targets without explicit SIMD support
+    for (size_t ii = SSE_END; ii < N; ++ii) {
+        const float x = input[ii];
+        const float y = x*_b0[ii] + _x1[ii]*_b1[ii] + _x2[ii]*_b2[ii] - _y1[ii]*_a1[ii] - _y2[ii]*_a2[ii];
+        _x2[ii] = _x1[ii];
+        _x1[ii] = x;
+        _y2[ii] = _y1[ii];
+        _y1[ii] = y;
+        if constexpr (WEIGHTED) {
+            output[ii] = (y - x)*_weight[ii] + x;
+        } else {
+            output[ii] = y;
+        }
+    }
+}
+
+/*!
+Note: weight must be in range [0, 1].
+*/
+template <size_t N>
+inline void BiquadFilterBank<N>::set_low_pass_frequencyWeighted(size_t lane, float frequency_hz, float weight)
+{
+    _weight[lane] = weight;
+
+    const float omega = frequency_hz*_2_pi_looptime_seconds[lane];
+    float sin_omega {};
+    float cos_omega {};
+    FilterTrig::sincos(omega, sin_omega, cos_omega);
+    const float alpha = sin_omega*_2q_reciprocal[lane];
+    const float a0_reciprocal = 1.0F/(1.0F + alpha);
+
+    _b1[lane] = (1.0F - cos_omega)*a0_reciprocal;
+    _b0[lane] = _b1[lane]*0.5F;
+    _b2[lane] = _b0[lane];
+    _a1[lane] = -2.0F*cos_omega*a0_reciprocal;
+    _a2[lane] = (1.0F - alpha)*a0_reciprocal;
+}
+
+/*!
+Note: weight must be in range [0, 1].
+*/
+template <size_t N>
+inline void BiquadFilterBank<N>::set_notch_frequency_weighted(size_t lane, float frequency_hz, float weight)
+{
+    const float omega = frequency_hz*_2_pi_looptime_seconds[lane];
+    float sin_omega {};
+    float cos_omega {};
+    FilterTrig::sincos(omega, sin_omega, cos_omega);
+    set_notch_frequency_weighted(lane, sin_omega, 2.0F*cos_omega, weight);
+}
+
+/*!
+Note: weight must be in range [0, 1].
+*/
+template <size_t N>
+inline void BiquadFilterBank<N>::set_notch_frequency_weighted(size_t lane, float sin_omega, float two_cos_omega, float weight)
+{
+    _weight[lane] = weight;
+
+    const float alpha = sin_omega*_2q_reciprocal[lane];
+    const float a0_reciprocal = 1.0F/(1.0F + alpha);
+
+    _b0[lane] = a0_reciprocal;
+    _b2[lane] = a0_reciprocal;
+    _b1[lane] = -two_cos_omega*a0_reciprocal;
+    _a1[lane] = _b1[lane];
+    _a2[lane] = (1.0F - alpha)*a0_reciprocal;
+}
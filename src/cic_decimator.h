@@ -0,0 +1,210 @@
+#pragma once
+
+#include "fir_filter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+/*!
+Cascaded integrator-comb (CIC) decimator, decimating by `Ratio` using `Stages` integrator and comb stages.
+
+The integrators run at the input rate and the combs at the output rate, so the cost per input sample is `Stages` integer additions,
+independent of `Ratio`. There are no multiplications except the conversion of each output to float.
+The response is that of `Stages` cascaded moving averages of length `Ratio`, so `CICDecimator<1, Ratio>` is equivalent to
+`FilterMovingAverage<Ratio>` followed by keeping one output in every `Ratio`.
+
+The integrators are held in unsigned 64 bit registers and are allowed to wrap: since the output of the combs is bounded,
+modular arithmetic gives the correct result provided the output fits in the register, that is
+`input_bits + Stages*log2(Ratio) <= 64`, which is checked at compile time for the input type.
+
+The output is scaled by `1/Ratio^Stages` to give unity DC gain, in the units of the input.
+
+The CIC response droops across the passband, `CompensationTaps > 0` adds a linear-phase FIR at the output rate
+which compensates for this, see `init_compensation()`.
+*/
+template <size_t Stages, size_t Ratio, size_t CompensationTaps = 0>
+class CICDecimator {
+public:
+    static_assert(Stages >= 1, "Stages must be at least 1");
+    static_assert(Ratio >= 2, "Ratio must be at least 2");
+    static constexpr size_t REGISTER_GROWTH_BITS = Stages*std::bit_width(Ratio - 1); //!< ceil(Stages*log2(Ratio))
+public:
+    CICDecimator() { init_compensation(0.5F); }
+    static constexpr size_t ratio() { return Ratio; }
+
+    void reset();
+    //! Latency in input samples, including that of the compensation filter.
+    static constexpr float latency() { return static_cast<float>(Stages*(Ratio - 1))*0.5F + FIRFilter<COMPENSATION_TAPS>::group_delay()*static_cast<float>(Ratio); }
+
+    //! Adds an input sample, returns true and sets `output` if this sample completes an output.
+    template <typename T>
+    bool filter(T input, float& output);
+    /*!
+    Filters `count` samples of `int16_t` or `int32_t` input, writing up to `count/Ratio + 1` samples to `output`, and returns the number of output samples written.
+    Partial phases are carried over to the next call, so the input can be split into blocks of any size.
+    */
+    template <typename T>
+    size_t filter_block(const T* input, float* output, size_t count);
+
+    void init_compensation(float passband_fraction);
+    const std::array<float, std::max(CompensationTaps, size_t{1})>& get_compensation_coefficients() const { return _compensation.get_coefficients(); }
+    //! Magnitude response of the CIC filter, `frequency` is normalized to the output sample rate, so the output Nyquist frequency is 0.5.
+    static float magnitude_response(float frequency);
+private:
+    static constexpr size_t COMPENSATION_TAPS = std::max(CompensationTaps, size_t{1});
+    template <typename T>
+    static constexpr void check_input_type() {
+        static_assert(std::numeric_limits<T>::is_integer, "input must be an integer type, eg int16_t or int32_t");
+        static_assert(std::numeric_limits<T>::digits + 1 + REGISTER_GROWTH_BITS <= 64, "CIC register growth exceeds 64 bits for this input type");
+    }
+    template <typename T>
+    static void integrate(std::array<uint64_t, Stages>& integrators, T input) {
+        integrators[0] += static_cast<uint64_t>(static_cast<int64_t>(input));
+        for (size_t ii = 1; ii < Stages; ++ii) {
+            integrators[ii] += integrators[ii - 1];
+        }
+    }
+    float comb(uint64_t value);
+    static constexpr float gain_reciprocal() {
+        float gain = 1.0F;
+        for (size_t ii = 0; ii < Stages; ++ii) {
+            gain *= static_cast<float>(Ratio);
+        }
+        return 1.0F/gain;
+    }
+protected:
+    std::array<uint64_t, Stages> _integrators {};
+    std::array<uint64_t, Stages> _comb_delays {};
+    size_t _phase {0};
+    FIRFilter<COMPENSATION_TAPS> _compensation;
+protected:
+    static constexpr float PI_F = 3.14159265358979323846F;
+};
+
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+inline void CICDecimator<Stages, Ratio, CompensationTaps>::reset()
+{
+    _integrators.fill(0);
+    _comb_delays.fill(0);
+    _phase = 0;
+    _compensation.reset();
+}
+
+/*!
+Runs the combs on `value`, the output of the last integrator, and converts the result to float.
+*/
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+inline float CICDecimator<Stages, Ratio, CompensationTaps>::comb(uint64_t value)
+{
+    for (size_t ii = 0; ii < Stages; ++ii) {
+        const uint64_t delayed = _comb_delays[ii];
+        _comb_delays[ii] = value;
+        value -= delayed;
+    }
+    const float output = static_cast<float>(static_cast<int64_t>(value))*gain_reciprocal();
+    if constexpr (CompensationTaps > 0) {
+        return _compensation.filter(output);
+    }
+    return output;
+}
+
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+template <typename T>
+inline bool CICDecimator<Stages, Ratio, CompensationTaps>::filter(T input, float& output)
+{
+    check_input_type<T>();
+    integrate(_integrators, input);
+    if (++_phase < Ratio) {
+        return false;
+    }
+    _phase = 0;
+    output = comb(_integrators[Stages - 1]);
+    return true;
+}
+
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+template <typename T>
+size_t CICDecimator<Stages, Ratio, CompensationTaps>::filter_block(const T* input, float* output, size_t count)
+{
+    check_input_type<T>();
+    size_t output_count = 0;
+    size_t ii = 0;
+    // complete any partial phase from the previous call
+    if (_phase > 0) {
+        for (; ii < count && _phase < Ratio; ++ii, ++_phase) {
+            integrate(_integrators, input[ii]);
+        }
+        if (_phase < Ratio) {
+            return 0;
+        }
+        output[output_count++] = comb(_integrators[Stages - 1]);
+        _phase = 0;
+    }
+    // whole output samples, the integrators are copied to a local array, so they can be held in registers
+    std::array<uint64_t, Stages> integrators = _integrators;
+    for (; ii + Ratio <= count; ii += Ratio) {
+        for (size_t jj = 0; jj < Ratio; ++jj) {
+            integrate(integrators, input[ii + jj]);
+        }
+        output[output_count++] = comb(integrators[Stages - 1]);
+    }
+    _integrators = integrators;
+    // start of the next partial phase, fewer than Ratio samples
+    const size_t remaining = count - ii;
+    for (size_t jj = 0; jj < remaining; ++jj) {
+        integrate(_integrators, input[ii + jj]);
+    }
+    _phase += remaining;
+    return output_count;
+}
+
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+float CICDecimator<Stages, Ratio, CompensationTaps>::magnitude_response(float frequency)
+{
+    if (frequency == 0.0F) {
+        return 1.0F;
+    }
+    const float x = PI_F*frequency;
+    const float response = sinf(x)/(static_cast<float>(Ratio)*sinf(x/static_cast<float>(Ratio)));
+    return powf(fabsf(response), static_cast<float>(Stages));
+}
+
+/*!
+Designs the compensation filter, which has the inverse of the CIC response up to `passband_fraction` of the output Nyquist frequency, and zero response above it.
+The coefficients are calculated by numerically integrating the desired response and are then windowed with a Hamming window and normalized to unity DC gain.
+Has no effect if `CompensationTaps` is zero.
+*/
+template <size_t Stages, size_t Ratio, size_t CompensationTaps>
+void CICDecimator<Stages, Ratio, CompensationTaps>::init_compensation(float passband_fraction)
+{
+    std::array<float, COMPENSATION_TAPS> coefficients {};
+    coefficients[0] = 1.0F;
+    if constexpr (CompensationTaps > 1) {
+        constexpr int STEPS = 256;
+        const float passband = 0.5F*passband_fraction;
+        const float df = passband/static_cast<float>(STEPS);
+        const float middle = FIRFilter<COMPENSATION_TAPS>::group_delay();
+        float sum = 0.0F;
+        for (size_t ii = 0; ii < COMPENSATION_TAPS; ++ii) {
+            const float n = static_cast<float>(ii) - middle;
+            float h = 0.0F;
+            // midpoint rule integration of 2*D(f)*cos(2*PI*f*n) over [0, passband]
+            for (int step = 0; step < STEPS; ++step) {
+                const float f = (static_cast<float>(step) + 0.5F)*df;
+                h += cosf(2.0F*PI_F*f*n)/magnitude_response(f);
+            }
+            const float window = 0.54F - 0.46F*cosf(2.0F*PI_F*static_cast<float>(ii)/static_cast<float>(COMPENSATION_TAPS - 1));
+            coefficients[ii] = 2.0F*h*df*window;
+            sum += coefficients[ii];
+        }
+        for (float& coefficient : coefficients) {
+            coefficient /= sum;
+        }
+    }
+    _compensation.set_coefficients(coefficients);
+    _compensation.reset();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+
+/*!
+Protection against subnormal (denormal) floats in the state of recursive filters.
+
+When the input to an IIR filter decays to zero its state decays towards zero and eventually becomes subnormal.
+On many processors arithmetic on subnormals is handled in microcode and is many times slower than normal arithmetic.
+Worse, with round to nearest the state of a lowpass filter can get stuck at the smallest subnormal, so the slowdown is permanent.
+
+There are two remedies:
+
+1. `DenormalGuard`, a scoped guard that sets the flush-to-zero (and, on x86, denormals-are-zero) mode of the floating point unit,
+   and restores the previous mode when it goes out of scope. This has no per-sample cost, so is the preferred option around
+   bank or block processing:
+
+        {
+            const DenormalGuard guard;
+            bank.filter(input, output);
+        }
+
+2. `flush_denormals()` on the IIR filters, which sets any state values smaller in magnitude than `FilterDenormal::THRESHOLD` to zero.
+   This costs a comparison per state value and works on any target, including those where the floating point mode cannot be changed.
+   Call it once per loop, after filtering.
+*/
+struct FilterDenormal {
+    //! Values smaller than this are flushed, chosen so that the product of a flushed value and any filter coefficient is still a normal float.
+    static constexpr float THRESHOLD = 1e-30F;
+
+    static void flush(float& value) {
+        if (std::fabs(value) < THRESHOLD) {
+            value = 0.0F;
+        }
+    }
+    //! Flushes each component of a vector type, such as `xyz_t`, or each lane of a `FilterLanes4`.
+    template <typename T>
+    static void flush(T& value) {
+        if constexpr (requires { value.flush_below(THRESHOLD); }) { value.flush_below(THRESHOLD); }
+        if constexpr (requires { value.x; }) { flush(value.x); }
+        if constexpr (requires { value.y; }) { flush(value.y); }
+        if constexpr (requires { value.z; }) { flush(value.z); }
+        if constexpr (requires { value.w; }) { flush(value.w); }
+    }
+};
+
+
+/*!
+Sets flush-to-zero mode for its lifetime, on x86 (SSE), AArch64 and 32 bit ARM with a VFP floating point unit (eg Cortex-M4F and M7).
+Has no effect on other targets, `is_supported()` returns false on those targets.
+
+The floating point mode is per thread, so the guard only affects the thread that creates it.
+The guard is independent of `LIBRARY_FILTER_NO_SIMD`, since on x86 scalar float arithmetic also uses the SSE unit.
+*/
+class DenormalGuard {
+public:
+    DenormalGuard() : _saved(get_control()) { set_control(_saved | FLUSH_BITS); }
+    ~DenormalGuard() { set_control(_saved); }
+    DenormalGuard(const DenormalGuard&) = delete;
+    DenormalGuard& operator=(const DenormalGuard&) = delete;
+    DenormalGuard(DenormalGuard&&) = delete;
+    DenormalGuard& operator=(DenormalGuard&&) = delete;
+public:
+    static constexpr bool is_supported() { return FLUSH_BITS != 0; }
+#if defined(__aarch64__)
+    using control_t = uint64_t;
+#else
+    using control_t = uint32_t;
+#endif
+private:
+#if defined(__SSE__) || defined(_M_X64)
+    static constexpr control_t FLUSH_BITS = 0x8040; // MXCSR flush-to-zero (bit 15) and denormals-are-zero (bit 6)
+    static control_t get_control() { return _mm_getcsr(); }
+    static void set_control(control_t control) { _mm_setcsr(control); }
+#elif defined(__aarch64__)
+    static constexpr control_t FLUSH_BITS = 1U << 24U; // FPCR.FZ
+    static control_t get_control() { control_t control {}; __asm__ volatile("mrs %0, fpcr" : "=r"(control)); return control; }
+    static void set_control(control_t control) { __asm__ volatile("msr fpcr, %0" : : "r"(control)); }
+#elif defined(__ARM_FP)
+    static constexpr control_t FLUSH_BITS = 1U << 24U; // FPSCR.FZ
+    static control_t get_control() { control_t control {}; __asm__ volatile("vmrs %0, fpscr" : "=r"(control)); return control; }
+    static void set_control(control_t control) { __asm__ volatile("vmsr fpscr, %0" : : "r"(control)); }
+#else
+    static constexpr control_t FLUSH_BITS = 0;
+    static control_t get_control() { return 0; }
+    static void set_control(control_t control) { (void)control; }
+#endif
+private:
+    control_t _saved;
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "filters.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
+
+/*!
+Compile-time design of Butterworth, Chebyshev (type I) and Bessel lowpass filters as cascades of second order sections.
+
+Each design function returns `(Order + 1)/2` sets of `biquad_coefficients_t`. For odd orders the first section is first order (b2 == a2 == 0).
+The remaining sections are ordered by increasing Q, which keeps the intermediate signal levels low.
+The functions are `constexpr`, so for fixed loop times the coefficients can be calculated at compile time and held in read-only memory:
+
+    static constexpr auto LOWPASS = FilterDesign::butterworth_lowpass<4>(100.0F, 0.000125F);
+    BiquadCascade<2> filter(LOWPASS);
+
+The analog prototype is transformed using the bilinear transform, prewarped so the cutoff frequency is exact.
+Butterworth and Bessel filters are -3dB at the cutoff frequency, Chebyshev filters are at the bottom of the passband ripple at the cutoff frequency.
+The Chebyshev `ripple_db` must be greater than zero.
+`cutoff_frequency_hz` must be less than the Nyquist frequency, 0.5/looptime_seconds.
+*/
+class FilterDesign {
+public:
+    //! Analog prototype section, normalized to a cutoff of 1 rad/s. `q == 0` denotes a first order section with its pole at `-omega`.
+    struct analog_section_t {
+        double omega;
+        double q;
+    };
+    static constexpr size_t section_count(size_t order) { return (order + 1)/2; }
+    static constexpr size_t MAX_BESSEL_ORDER = 8;
+public:
+    template <size_t Order>
+    static constexpr std::array<biquad_coefficients_t, (Order + 1)/2> butterworth_lowpass(float cutoff_frequency_hz, float looptime_seconds);
+    template <size_t Order>
+    static constexpr std::array<biquad_coefficients_t, (Order + 1)/2> chebyshev_lowpass(float cutoff_frequency_hz, float looptime_seconds, float ripple_db);
+    template <size_t Order>
+    static constexpr std::array<biquad_coefficients_t, (Order + 1)/2> bessel_lowpass(float cutoff_frequency_hz, float looptime_seconds);
+
+    template <size_t Sections>
+    static constexpr std::array<biquad_coefficients_t, Sections> bilinear_lowpass(const std::array<analog_section_t, Sections>& sections, float cutoff_frequency_hz, float looptime_seconds, double gain);
+public:
+    // constexpr versions of the maths functions needed for filter design, evaluated in double precision
+    static constexpr double PI = 3.14159265358979323846;
+    static constexpr double sqrt(double x);
+    static constexpr double exp(double x);
+    static constexpr double log(double x); //!< returns -inf for 0, +inf for +inf and NaN for negative x
+    static constexpr double asinh(double x) { return log(x + sqrt(x*x + 1.0)); }
+    static constexpr double sinh(double x) { return (exp(x) - exp(-x))*0.5; }
+    static constexpr double cosh(double x) { return (exp(x) + exp(-x))*0.5; }
+    static constexpr double sin(double x); //!< valid for x in range [-PI, PI]
+    static constexpr double cos(double x) { return sin(PI/2.0 - x); } //!< valid for x in range [-PI/2, 3*PI/2]
+    static constexpr double tan(double x) { return sin(x)/cos(x); } //!< valid for x in range (-PI/2, PI/2)
+private:
+    //! Bessel analog prototype sections, magnitude normalized so that the response is -3dB at 1 rad/s.
+    static constexpr std::array<std::array<analog_section_t, (MAX_BESSEL_ORDER + 1)/2>, MAX_BESSEL_ORDER + 1> BESSEL_SECTIONS = {{
+        {{ }},
+        {{ {1.000000000000, 0.0} }},
+        {{ {1.272019649514, 0.577350269190} }},
+        {{ {1.322675799910, 0.0}, {1.447617133147, 0.691046625825} }},
+        {{ {1.430171559994, 0.521934581669}, {1.603357516217, 0.805538281842} }},
+        {{ {1.502316271447, 0.0}, {1.556347122297, 0.563535620851}, {1.755377776637, 0.916477373948} }},
+        {{ {1.603919128774, 0.510317824749}, {1.689168267620, 0.611194546878}, {1.904707612303, 1.023313953827} }},
+        {{ {1.684368179273, 0.0}, {1.716356044871, 0.532355697900}, {1.822417478858, 0.660821389297}, {2.049490900269, 1.126257541983} }},
+        {{ {1.778465911775, 0.505991069397}, {1.832092601199, 0.559609164796}, {1.953195759022, 0.710852074442}, {2.188726230527, 1.225669425408} }}
+    }};
+};
+
+template <size_t Order>
+constexpr std::array<biquad_coefficients_t, (Order + 1)/2> FilterDesign::butterworth_lowpass(float cutoff_frequency_hz, float looptime_seconds)
+{
+    static_assert(Order > 0, "Order must be at least 1");
+    std::array<analog_section_t, (Order + 1)/2> sections {};
+    size_t index = 0;
+    if constexpr (Order % 2 == 1) {
+        sections[index++] = analog_section_t { 1.0, 0.0 };
+    }
+    // poles at angle theta from the imaginary axis, iterate so that q is increasing
+    for (size_t k = Order/2; k > 0; --k) {
+        const double theta = PI*static_cast<double>(2*k - 1)/static_cast<double>(2*Order);
+        sections[index++] = analog_section_t { 1.0, 1.0/(2.0*sin(theta)) };
+    }
+    return bilinear_lowpass(sections, cutoff_frequency_hz, looptime_seconds, 1.0);
+}
+
+template <size_t Order>
+constexpr std::array<biquad_coefficients_t, (Order + 1)/2> FilterDesign::chebyshev_lowpass(float cutoff_frequency_hz, float looptime_seconds, float ripple_db)
+{
+    static_assert(Order > 0, "Order must be at least 1");
+    assert(ripple_db > 0.0F && "ripple must be greater than zero");
+    const double epsilon = sqrt(exp(static_cast<double>(ripple_db)*log(10.0)/10.0) - 1.0);
+    const double mu = asinh(1.0/epsilon)/static_cast<double>(Order);
+    const double sinh_mu = sinh(mu);
+    const double cosh_mu = cosh(mu);
+
+    std::array<analog_section_t, (Order + 1)/2> sections {};
+    size_t index = 0;
+    if constexpr (Order % 2 == 1) {
+        sections[index++] = analog_section_t { sinh_mu, 0.0 };
+    }
+    for (size_t k = Order/2; k > 0; --k) {
+        const double theta = PI*static_cast<double>(2*k - 1)/static_cast<double>(2*Order);
+        const double sigma = sinh_mu*sin(theta);
+        const double omega = cosh_mu*cos(theta);
+        const double omega0 = sqrt(sigma*sigma + omega*omega);
+        sections[index++] = analog_section_t { omega0, omega0/(2.0*sigma) };
+    }
+    // each section has unity DC gain, even order filters have DC gain at the bottom of the ripple
+    const double gain = (Order % 2 == 0) ? 1.0/sqrt(1.0 + epsilon*epsilon) : 1.0;
+    return bilinear_lowpass(sections, cutoff_frequency_hz, looptime_seconds, gain);
+}
+
+template <size_t Order>
+constexpr std::array<biquad_coefficients_t, (Order + 1)/2> FilterDesign::bessel_lowpass(float cutoff_frequency_hz, float looptime_seconds)
+{
+    static_assert(Order > 0 && Order <= MAX_BESSEL_ORDER, "Bessel filters are tabulated for orders 1 to 8");
+    std::array<analog_section_t, (Order + 1)/2> sections {};
+    for (size_t ii = 0; ii < sections.size(); ++ii) {
+        sections[ii] = BESSEL_SECTIONS[Order][ii];
+    }
+    return bilinear_lowpass(sections, cutoff_frequency_hz, looptime_seconds, 1.0);
+}
+
+/*!
+Transforms normalized analog lowpass sections to digital sections using the bilinear transform, prewarped at the cutoff frequency.
+`gain` is applied to the first section.
+*/
+template <size_t Sections>
+constexpr std::array<biquad_coefficients_t, Sections> FilterDesign::bilinear_lowpass(const std::array<analog_section_t, Sections>& sections, float cutoff_frequency_hz, float looptime_seconds, double gain)
+{
+    const double K = tan(PI*static_cast<double>(cutoff_frequency_hz)*static_cast<double>(looptime_seconds));
+    std::array<biquad_coefficients_t, Sections> ret {};
+    for (size_t ii = 0; ii < Sections; ++ii) {
+        const double k = K*sections[ii].omega;
+        const double g = ii == 0 ? gain : 1.0;
+        if (sections[ii].q == 0.0) {
+            const double norm = 1.0/(1.0 + k);
+            const double b0 = k*norm*g;
+            ret[ii] = biquad_coefficients_t { static_cast<float>((k - 1.0)*norm), 0.0F, static_cast<float>(b0), static_cast<float>(b0), 0.0F };
+        } else {
+            const double k_over_q = k/sections[ii].q;
+            const double k2 = k*k;
+            const double norm = 1.0/(1.0 + k_over_q + k2);
+            const double b0 = k2*norm*g;
+            ret[ii] = biquad_coefficients_t {
+                static_cast<float>(2.0*(k2 - 1.0)*norm),
+                static_cast<float>((1.0 - k_over_q + k2)*norm),
+                static_cast<float>(b0),
+                static_cast<float>(2.0*b0),
+                static_cast<float>(b0)
+            };
+        }
+    }
+    return ret;
+}
+
+constexpr double FilterDesign::sqrt(double x)
+{
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+    double y = x > 1.0 ? x : 1.0;
+    for (int ii = 0; ii < 100; ++ii) {
+        const double next = 0.5*(y + x/y);
+        if (next == y) {
+            break;
+        }
+        y = next;
+    }
+    return y;
+}
+
+constexpr double FilterDesign::exp(double x)
+{
+    // infinities would never be reduced
+    if (x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+    if (x == -std::numeric_limits<double>::infinity()) {
+        return 0.0;
+    }
+    // reduce x so that |x| < 0.5, sum the Taylor series, and then square the result back up
+    int squarings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x *= 0.5;
+        ++squarings;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= x/static_cast<double>(n);
+        sum += term;
+    }
+    for (int ii = 0; ii < squarings; ++ii) {
+        sum *= sum;
+    }
+    return sum;
+}
+
+constexpr double FilterDesign::log(double x)
+{
+    // reduce x to the range [1, 2), then use log(x) = 2*atanh((x - 1)/(x + 1))
+    constexpr double LN2 = 0.693147180559945309417;
+    // zero, infinity, negative values and NaN would never be reduced to the range
+    if (x == 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    if (x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+    if (!(x > 0.0)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    int exponent = 0;
+    while (x >= 2.0) {
+        x *= 0.5;
+        ++exponent;
+    }
+    while (x < 1.0) {
+        x *= 2.0;
+        --exponent;
+    }
+    const double z = (x - 1.0)/(x + 1.0);
+    const double z2 = z*z;
+    double term = z;
+    double sum = 0.0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term/static_cast<double>(n);
+        term *= z2;
+    }
+    return 2.0*sum + static_cast<double>(exponent)*LN2;
+}
+
+constexpr double FilterDesign::sin(double x)
+{
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 30; ++n) {
+        term *= -x*x/static_cast<double>((2*n)*(2*n + 1));
+        sum += term;
+    }
+    return sum;
+}
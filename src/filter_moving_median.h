@@ -0,0 +1,230 @@
+#pragma once
+
+#include "filter_simd.h"
+#include "filters.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+
+/*!
+Moving median filter, the median of the last `N` inputs.
+
+Unlike `FilterMovingAverage`, single sample spikes are removed entirely rather than being spread across the window.
+
+The window is held as two heaps: a max-heap of the lower half of the samples and a min-heap of the upper half, so the median
+is at the top of the heaps. Each sample remembers its position in its heap, so when the oldest sample is replaced by the input it is
+sifted to its new position and at most one pair of samples is exchanged between the heaps.
+This gives O(log N) comparisons per sample, compared with O(N) for inserting into a sorted window and O(N log N) for sorting.
+
+The samples are held in arrival order, like `RollingBuffer`, but in a plain array, since the heaps refer to samples by their index.
+Until `N` samples have been filtered the output is the median of the samples so far.
+For even `N` the output is the mean of the two middle samples.
+*/
+template <size_t N>
+class FilterMovingMedian : public FilterBase {
+public:
+    static_assert(N >= 2, "N must be at least 2");
+    FilterMovingMedian() = default;
+public:
+    void reset() { _count = 0; _index = 0; _low_size = 0; _high_size = 0; }
+
+    float filter(float input);
+    float filter(float input, float dt) { (void)dt; return filter(input); }
+    virtual float filter_virtual(float input) override { return filter(input); }
+    void filter_block(const float* input, float* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    //! The median of the current window, that is the value returned by the last call to `filter`.
+    float median() const {
+        if (_count == 0) {
+            return 0.0F;
+        }
+        const float low = _samples[_low[0]];
+        return _low_size > _high_size ? low : (low + _samples[_high[0]])*0.5F;
+    }
+    size_t size() const { return _count; }
+    static constexpr size_t capacity() { return N; }
+protected:
+    static constexpr size_t LOW_CAPACITY = (N + 1)/2;
+    static constexpr size_t HIGH_CAPACITY = N/2;
+    //! true if the sample in `slot_a` belongs nearer the top of the heap than the sample in `slot_b`
+    template <bool LOW>
+    bool before(size_t slot_a, size_t slot_b) const { return LOW ? _samples[slot_a] > _samples[slot_b] : _samples[slot_a] < _samples[slot_b]; }
+    template <bool LOW>
+    size_t* heap() { if constexpr (LOW) { return &_low[0]; } else { return &_high[0]; } }
+    template <bool LOW>
+    void place(size_t position, size_t slot) { heap<LOW>()[position] = slot; _position[slot] = position; _in_low[slot] = LOW; }
+    template <bool LOW>
+    size_t sift_up(size_t position);
+    template <bool LOW>
+    void sift_down(size_t position);
+    void rebalance();
+protected:
+    size_t _count {0}; //!< number of samples in the window
+    size_t _index {0}; //!< slot for the next sample, once the window is full this is the oldest sample
+    size_t _low_size {0};
+    size_t _high_size {0};
+    std::array<float, N> _samples {}; //!< samples in arrival order
+    std::array<size_t, N> _position {}; //!< position of each sample in its heap
+    std::array<bool, N> _in_low {}; //!< true if the sample is in the low heap
+    std::array<size_t, LOW_CAPACITY> _low {}; //!< max-heap of the slots of the lower half of the samples
+    std::array<size_t, HIGH_CAPACITY> _high {}; //!< min-heap of the slots of the upper half of the samples
+};
+
+template <size_t N>
+template <bool LOW>
+size_t FilterMovingMedian<N>::sift_up(size_t position)
+{
+    size_t* const h = heap<LOW>();
+    const size_t slot = h[position];
+    while (position > 0) {
+        const size_t parent = (position - 1)/2;
+        if (!before<LOW>(slot, h[parent])) {
+            break;
+        }
+        place<LOW>(position, h[parent]);
+        position = parent;
+    }
+    place<LOW>(position, slot);
+    return position;
+}
+
+template <size_t N>
+template <bool LOW>
+void FilterMovingMedian<N>::sift_down(size_t position)
+{
+    size_t* const h = heap<LOW>();
+    const size_t size = LOW ? _low_size : _high_size;
+    const size_t slot = h[position];
+    while (true) {
+        size_t child = 2*position + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && before<LOW>(h[child + 1], h[child])) {
+            ++child;
+        }
+        if (!before<LOW>(h[child], slot)) {
+            break;
+        }
+        place<LOW>(position, h[child]);
+        position = child;
+    }
+    place<LOW>(position, slot);
+}
+
+/*!
+Restores the ordering between the heaps, after a single sample has been added or changed.
+All the samples in the low heap are then less than or equal to all the samples in the high heap.
+*/
+template <size_t N>
+void FilterMovingMedian<N>::rebalance()
+{
+    if (_high_size > 0 && _samples[_low[0]] > _samples[_high[0]]) {
+        const size_t low_top = _low[0];
+        place<true>(0, _high[0]);
+        place<false>(0, low_top);
+        sift_down<true>(0);
+        sift_down<false>(0);
+    }
+}
+
+template <size_t N>
+float FilterMovingMedian<N>::filter(float input)
+{
+    const size_t slot = _index;
+    _samples[slot] = input;
+    if (_count < N) {
+        // window not yet full, add the sample to the smaller heap, preferring the low heap
+        ++_count;
+        if (_low_size == _high_size) {
+            place<true>(_low_size++, slot);
+            sift_up<true>(_position[slot]);
+        } else {
+            place<false>(_high_size++, slot);
+            sift_up<false>(_position[slot]);
+        }
+    } else if (_in_low[slot]) {
+        // the input has replaced the oldest sample, so move it to its new position in the same heap
+        sift_down<true>(sift_up<true>(_position[slot]));
+    } else {
+        sift_down<false>(sift_up<false>(_position[slot]));
+    }
+    rebalance();
+    _index = (_index + 1 == N) ? 0 : _index + 1;
+    return median();
+}
+
+
+/*!
+Hampel filter, a moving median filter that replaces only outliers.
+
+An input is an outlier if its distance from the median of the window exceeds `n_sigmas` times the scaled median absolute deviation (MAD)
+of the window, that is `1.4826*MAD`, which is an estimate of the standard deviation that is robust to outliers.
+Outliers are replaced by the median, all other inputs are passed through unchanged.
+The window includes the current input, and holds the inputs rather than the outputs, so a replaced outlier still counts towards later windows.
+
+Calculating the MAD requires a second median, instead the outlier test is done without it:
+`|input - median| > n_sigmas*1.4826*MAD` exactly when more than half of the window lies within `|input - median|/(n_sigmas*1.4826)` of the median.
+That is a single O(N) counting pass, with no sorting or branching, using SIMD where available (see `FilterSimd::count_within`), and is only done for inputs that differ from the median.
+For even window sizes the upper of the two middle deviations is used as the MAD.
+*/
+template <size_t N>
+class FilterHampel : public FilterMovingMedian<N> {
+public:
+    static constexpr float MAD_SCALE = 1.4826F; //!< MAD of a normal distribution times this is its standard deviation
+    explicit FilterHampel(float n_sigmas) { set_threshold(n_sigmas); }
+    FilterHampel() : FilterHampel(3.0F) {}
+public:
+    void set_threshold(float n_sigmas) { assert(n_sigmas > 0.0F && "threshold must be greater than zero"); _threshold_reciprocal = 1.0F/(n_sigmas*MAD_SCALE); }
+    void reset() { FilterMovingMedian<N>::reset(); _is_outlier = false; }
+
+    float filter(float input);
+    float filter(float input, float dt) { (void)dt; return filter(input); }
+    virtual float filter_virtual(float input) override { return filter(input); }
+    void filter_block(const float* input, float* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    //! true if the last input was an outlier and was replaced by the median.
+    bool is_outlier() const { return _is_outlier; }
+protected:
+    //! Number of samples in the window within `within` of `median`, the window is `_samples[0, _count)`.
+    uint32_t count_within(float median, float within) const {
+        if (this->_count == N) {
+            return FilterSimd::count_within<N>(&this->_samples[0], median, within);
+        }
+        uint32_t count = 0;
+        for (size_t ii = 0; ii < this->_count; ++ii) {
+            count += std::fabs(this->_samples[ii] - median) < within ? 1U : 0U;
+        }
+        return count;
+    }
+protected:
+    float _threshold_reciprocal {};
+    bool _is_outlier {false};
+};
+
+template <size_t N>
+float FilterHampel<N>::filter(float input)
+{
+    const float median = FilterMovingMedian<N>::filter(input);
+    const float deviation = std::fabs(input - median);
+    _is_outlier = false;
+    if (deviation == 0.0F) {
+        return input;
+    }
+    const float within = deviation*_threshold_reciprocal;
+    _is_outlier = count_within(median, within) > this->_count/2;
+    return _is_outlier ? median : input;
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "filters.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*!
+Offline, parallel in time, filtering of long recorded signals, eg rerunning filters over flight logs on a desktop machine.
+Requires `std::thread`, so is for host use only, it is not used by any of the other filters.
+
+The recursion of an IIR filter makes filtering strictly serial, but the filters are linear, so the state after a chunk of samples is
+    state[end] = A^L*state[start] + f
+where `A` is the state transition matrix for a single sample, `L` is the length of the chunk and `f` is the state reached by
+filtering the chunk from zero state. `FilterParallel` uses this in three phases:
+
+1. The chunks are filtered from zero state in parallel, giving `f` for each chunk.
+2. The affine maps `(A^L, f)` of the chunks are combined by a parallel prefix scan, giving the start state of every chunk.
+3. The chunks are filtered again in parallel, each from its start state, writing the output.
+
+So each sample is filtered twice, and with `P` threads the throughput is about `P/2` times that of serial filtering.
+The output matches serial filtering to within float rounding, and the filter is left in the same state as serial filtering would leave it.
+*/
+
+
+/*!
+Access to the state of a filter as a vector of floats, for `FilterParallel`.
+Specialize this to use `FilterParallel` with other linear filters, the state must be updated linearly by the input, with no constant term.
+*/
+template <typename FILTER>
+struct FilterStateTraits;
+
+template <>
+struct FilterStateTraits<PowerTransferFilter1> {
+    static constexpr size_t SIZE = 1;
+    using vector_t = std::array<float, SIZE>;
+    static vector_t get(const PowerTransferFilter1& filter) { return vector_t {{ filter.get_state() }}; }
+    static void set(PowerTransferFilter1& filter, const vector_t& state) { filter.set_state(state[0]); }
+};
+
+template <>
+struct FilterStateTraits<PowerTransferFilter2> {
+    static constexpr size_t SIZE = 2;
+    using vector_t = std::array<float, SIZE>;
+    static vector_t get(const PowerTransferFilter2& filter) { return filter.get_state(); }
+    static void set(PowerTransferFilter2& filter, const vector_t& state) { filter.set_state(state); }
+};
+
+template <>
+struct FilterStateTraits<PowerTransferFilter3> {
+    static constexpr size_t SIZE = 3;
+    using vector_t = std::array<float, SIZE>;
+    static vector_t get(const PowerTransferFilter3& filter) { return filter.get_state(); }
+    static void set(PowerTransferFilter3& filter, const vector_t& state) { filter.set_state(state); }
+};
+
+template <>
+struct FilterStateTraits<BiquadFilter> {
+    static constexpr size_t SIZE = 4;
+    using vector_t = std::array<float, SIZE>;
+    static vector_t get(const BiquadFilter& filter) {
+        const BiquadFilter::state_t& state = filter.get_state();
+        return vector_t {{ state.x1, state.x2, state.y1, state.y2 }};
+    }
+    static void set(BiquadFilter& filter, const vector_t& state) { filter.set_state(BiquadFilter::state_t { state[0], state[1], state[2], state[3] }); }
+};
+
+
+/*!
+Fixed set of worker threads, `run()` spreads a set of tasks across the workers and the calling thread.
+*/
+class FilterThreadPool {
+public:
+    //! `thread_count` includes the calling thread, so `thread_count - 1` worker threads are started.
+    explicit FilterThreadPool(size_t thread_count) {
+        for (size_t ii = 1; ii < thread_count; ++ii) {
+            _workers.emplace_back([this]() { work(); });
+        }
+    }
+    FilterThreadPool() : FilterThreadPool(std::max(1U, std::thread::hardware_concurrency())) {}
+    ~FilterThreadPool() {
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _start.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+    FilterThreadPool(const FilterThreadPool&) = delete;
+    FilterThreadPool& operator=(const FilterThreadPool&) = delete;
+    FilterThreadPool(FilterThreadPool&&) = delete;
+    FilterThreadPool& operator=(FilterThreadPool&&) = delete;
+public:
+    size_t thread_count() const { return _workers.size() + 1; }
+
+    //! Calls `task(index)` for each `index` in `[0, task_count)`, and returns when all the calls have completed.
+    void run(size_t task_count, const std::function<void(size_t)>& task) {
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _task_count = task_count;
+            _next = 0;
+            _completed = 0;
+            ++_generation;
+        }
+        _start.notify_all();
+        run_tasks();
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _completed == _task_count; });
+        _task = nullptr;
+    }
+private:
+    //! Takes tasks until there are none left.
+    void run_tasks() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_task != nullptr && _next < _task_count) {
+            const size_t index = _next++;
+            const std::function<void(size_t)>& task = *_task;
+            lock.unlock();
+            task(index);
+            lock.lock();
+            if (++_completed == _task_count) {
+                _done.notify_all();
+            }
+        }
+    }
+    void work() {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _start.wait(lock, [this, &generation]() { return _stopping || _generation != generation; });
+            if (_stopping) {
+                return;
+            }
+            generation = _generation;
+            lock.unlock();
+            run_tasks();
+            lock.lock();
+        }
+    }
+private:
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    const std::function<void(size_t)>* _task {nullptr};
+    size_t _task_count {0};
+    size_t _next {0};
+    size_t _completed {0};
+    uint64_t _generation {0};
+    bool _stopping {false};
+};
+
+
+/*!
+Parallel in time filtering of long signals using a `FilterThreadPool`, see the description at the top of this file.
+
+`FILTER` must have a `FilterStateTraits` specialization. The state transition matrices and the prefix scan use doubles,
+so the start states of the chunks are as accurate as the float state of serial filtering.
+*/
+template <typename FILTER>
+class FilterParallel {
+public:
+    using traits_t = FilterStateTraits<FILTER>;
+    static constexpr size_t SIZE = traits_t::SIZE;
+    using vector_t = typename traits_t::vector_t;
+    static constexpr size_t MIN_CHUNK_LENGTH = 4096; //!< shorter signals are split into fewer chunks, so the overhead of the scan stays small
+    //! The state after a chunk, `matrix*state + offset`, with `matrix` in row-major order.
+    struct affine_t {
+        std::array<double, SIZE*SIZE> matrix;
+        std::array<double, SIZE> offset;
+    };
+public:
+    explicit FilterParallel(FilterThreadPool& pool) : _pool(pool) {}
+public:
+    /*!
+    Filters `count` samples from `input` into `output`, which must not overlap, starting from the state of `filter`,
+    and leaves `filter` in the state after the last sample.
+    */
+    void filter_block(FILTER& filter, const float* input, float* output, size_t count);
+    //! `second` applied after `first`.
+    static affine_t after(const affine_t& second, const affine_t& first);
+    //! The state transition matrix of `filter` for a single sample.
+    static affine_t transition(const FILTER& filter);
+    //! The state transition matrix for `length` samples, by repeated squaring.
+    static affine_t transition(const FILTER& filter, size_t length);
+protected:
+    static void filter_chunk(FILTER& filter, const float* input, float* output, size_t count) {
+        if constexpr (requires { filter.filter_block(input, output, count); }) {
+            filter.filter_block(input, output, count);
+        } else {
+            // filter a local copy, so the state is not reloaded after each store to `output`, which might alias it
+            FILTER local = filter;
+            for (size_t ii = 0; ii < count; ++ii) {
+                output[ii] = local.filter(input[ii]);
+            }
+            filter = local;
+        }
+    }
+protected:
+    FilterThreadPool& _pool;
+};
+
+template <typename FILTER>
+typename FilterParallel<FILTER>::affine_t FilterParallel<FILTER>::after(const affine_t& second, const affine_t& first)
+{
+    affine_t result {};
+    for (size_t row = 0; row < SIZE; ++row) {
+        double offset = second.offset[row];
+        for (size_t kk = 0; kk < SIZE; ++kk) {
+            offset += second.matrix[row*SIZE + kk]*first.offset[kk];
+        }
+        result.offset[row] = offset;
+        for (size_t column = 0; column < SIZE; ++column) {
+            double sum = 0.0;
+            for (size_t kk = 0; kk < SIZE; ++kk) {
+                sum += second.matrix[row*SIZE + kk]*first.matrix[kk*SIZE + column];
+            }
+            result.matrix[row*SIZE + column] = sum;
+        }
+    }
+    return result;
+}
+
+/*!
+The filter is linear with no constant term, so column `ii` of the matrix is the state after filtering a zero input from the unit state `e[ii]`.
+*/
+template <typename FILTER>
+typename FilterParallel<FILTER>::affine_t FilterParallel<FILTER>::transition(const FILTER& filter)
+{
+    affine_t result {};
+    for (size_t column = 0; column < SIZE; ++column) {
+        FILTER unit = filter;
+        vector_t state {};
+        state[column] = 1.0F;
+        traits_t::set(unit, state);
+        unit.filter(0.0F);
+        state = traits_t::get(unit);
+        for (size_t row = 0; row < SIZE; ++row) {
+            result.matrix[row*SIZE + column] = static_cast<double>(state[row]);
+        }
+    }
+    return result;
+}
+
+template <typename FILTER>
+typename FilterParallel<FILTER>::affine_t FilterParallel<FILTER>::transition(const FILTER& filter, size_t length)
+{
+    affine_t result {};
+    for (size_t ii = 0; ii < SIZE; ++ii) {
+        result.matrix[ii*SIZE + ii] = 1.0;
+    }
+    affine_t power = transition(filter);
+    while (length > 0) {
+        if (length & 1U) {
+            result = after(power, result);
+        }
+        power = after(power, power);
+        length >>= 1U;
+    }
+    return result;
+}
+
+template <typename FILTER>
+void FilterParallel<FILTER>::filter_block(FILTER& filter, const float* input, float* output, size_t count)
+{
+    const size_t max_chunks = std::max(static_cast<size_t>(1), count/MIN_CHUNK_LENGTH);
+    const size_t chunk_target = std::min(_pool.thread_count(), max_chunks);
+    const size_t chunk_length = (count + chunk_target - 1)/chunk_target;
+    if (chunk_target <= 1) {
+        filter_chunk(filter, input, output, count);
+        return;
+    }
+    const size_t chunk_count = (count + chunk_length - 1)/chunk_length;
+
+    // phase 1: the state after each chunk except the last, from zero state, the output is used as scratch space
+    // all these chunks have length chunk_length, so they share the same transition matrix
+    const affine_t transition_chunk = transition(filter, chunk_length);
+    std::vector<affine_t> maps(chunk_count - 1);
+    _pool.run(chunk_count - 1, [&](size_t chunk) {
+        FILTER zero_state = filter;
+        traits_t::set(zero_state, vector_t {});
+        filter_chunk(zero_state, input + chunk*chunk_length, output + chunk*chunk_length, chunk_length);
+        const vector_t state = traits_t::get(zero_state);
+        maps[chunk].matrix = transition_chunk.matrix;
+        for (size_t ii = 0; ii < SIZE; ++ii) {
+            maps[chunk].offset[ii] = static_cast<double>(state[ii]);
+        }
+    });
+
+    // phase 2: inclusive prefix scan (Hillis-Steele), so that maps[chunk] takes the start state of chunk 0 to the end state of `chunk`
+    std::vector<affine_t> scanned(maps.size());
+    for (size_t distance = 1; distance < maps.size(); distance *= 2) {
+        _pool.run(maps.size(), [&](size_t ii) {
+            scanned[ii] = ii >= distance ? after(maps[ii], maps[ii - distance]) : maps[ii];
+        });
+        maps.swap(scanned);
+    }
+
+    // phase 3: filter each chunk from its start state
+    const vector_t initial = traits_t::get(filter);
+    std::vector<FILTER> chunk_filters(chunk_count, filter);
+    _pool.run(chunk_count, [&](size_t chunk) {
+        if (chunk > 0) {
+            const affine_t& map = maps[chunk - 1];
+            vector_t start {};
+            for (size_t row = 0; row < SIZE; ++row) {
+                double value = map.offset[row];
+                for (size_t kk = 0; kk < SIZE; ++kk) {
+                    value += map.matrix[row*SIZE + kk]*static_cast<double>(initial[kk]);
+                }
+                start[row] = static_cast<float>(value);
+            }
+            traits_t::set(chunk_filters[chunk], start);
+        }
+        const size_t begin = chunk*chunk_length;
+        filter_chunk(chunk_filters[chunk], input + begin, output + begin, std::min(chunk_length, count - begin));
+    });
+    filter = chunk_filters[chunk_count - 1];
+}
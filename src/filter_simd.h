@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*!
+SIMD support used by the filters.
+
+`LIBRARY_FILTER_SIMD_AVX`, `LIBRARY_FILTER_SIMD_SSE` or `LIBRARY_FILTER_SIMD_NEON` is defined when the target supports the instruction set.
+Define `LIBRARY_FILTER_NO_SIMD` to force the scalar implementations.
+*/
+#if !defined(LIBRARY_FILTER_NO_SIMD)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define LIBRARY_FILTER_SIMD_AVX
+#define LIBRARY_FILTER_SIMD_SSE
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define LIBRARY_FILTER_SIMD_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LIBRARY_FILTER_SIMD_NEON
+#endif
+#endif
+
+
+struct FilterSimd {
+    /*!
+    Returns the dot product of the `Count` elements of `a` and `b`.
+    Partial sums are accumulated in parallel, so the result may differ from a serial sum by float rounding.
+    `Count` is a template parameter so the loop bounds are compile-time constants.
+    */
+    template <size_t Count>
+    static float dot_product(const float* a, const float* b) {
+        size_t ii = 0;
+        float sum = 0.0F;
+#if defined(LIBRARY_FILTER_SIMD_AVX)
+        constexpr size_t AVX_END = Count - Count % 8;
+        __m256 sum8 = _mm256_setzero_ps();
+        for (; ii < AVX_END; ii += 8) {
+            sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(_mm256_loadu_ps(a + ii), _mm256_loadu_ps(b + ii)));
+        }
+        __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+#elif defined(LIBRARY_FILTER_SIMD_SSE)
+        __m128 sum4 = _mm_setzero_ps();
+#endif
+#if defined(LIBRARY_FILTER_SIMD_SSE)
+        constexpr size_t SSE_END = Count - Count % 4;
+        for (; ii < SSE_END; ii += 4) {
+            sum4 = _mm_add_ps(sum4, _mm_mul_ps(_mm_loadu_ps(a + ii), _mm_loadu_ps(b + ii)));
+        }
+        sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+        sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+        sum = _mm_cvtss_f32(sum4);
+#else
+        // four independent partial sums, so the multiply-adds can be pipelined
+        float sum0 = 0.0F;
+        float sum1 = 0.0F;
+        float sum2 = 0.0F;
+        float sum3 = 0.0F;
+        constexpr size_t UNROLL_END = Count - Count % 4;
+        for (; ii < UNROLL_END; ii += 4) {
+            sum0 += a[ii]*b[ii];
+            sum1 += a[ii + 1]*b[ii + 1];
+            sum2 += a[ii + 2]*b[ii + 2];
+            sum3 += a[ii + 3]*b[ii + 3];
+        }
+        sum = (sum0 + sum1) + (sum2 + sum3);
+#endif
+        for (; ii < Count; ++ii) {
+            sum += a[ii]*b[ii];
+        }
+        return sum;
+    }
+
+    /*!
+    Returns the number of the `Count` elements of `values` that are strictly within `radius` of `center`, that is `|value - center| < radius`.
+    The counts are accumulated as floats, which is exact for any array that fits in memory, so only float SIMD instructions are needed.
+    */
+    template <size_t Count>
+    static uint32_t count_within(const float* values, float center, float radius) {
+        size_t ii = 0;
+        uint32_t count = 0;
+#if defined(LIBRARY_FILTER_SIMD_AVX)
+        constexpr size_t AVX_END = Count - Count % 8;
+        const __m256 center8 = _mm256_set1_ps(center);
+        const __m256 radius8 = _mm256_set1_ps(radius);
+        const __m256 sign8 = _mm256_set1_ps(-0.0F);
+        const __m256 one8 = _mm256_set1_ps(1.0F);
+        __m256 count8 = _mm256_setzero_ps();
+        for (; ii < AVX_END; ii += 8) {
+            const __m256 deviation = _mm256_andnot_ps(sign8, _mm256_sub_ps(_mm256_loadu_ps(values + ii), center8));
+            count8 = _mm256_add_ps(count8, _mm256_and_ps(_mm256_cmp_ps(deviation, radius8, _CMP_LT_OQ), one8));
+        }
+        __m128 count4 = _mm_add_ps(_mm256_castps256_ps128(count8), _mm256_extractf128_ps(count8, 1));
+#elif defined(LIBRARY_FILTER_SIMD_SSE)
+        __m128 count4 = _mm_setzero_ps();
+#endif
+#if defined(LIBRARY_FILTER_SIMD_SSE)
+        constexpr size_t SSE_END = Count - Count % 4;
+        const __m128 center4 = _mm_set1_ps(center);
+        const __m128 radius4 = _mm_set1_ps(radius);
+        const __m128 sign4 = _mm_set1_ps(-0.0F);
+        const __m128 one4 = _mm_set1_ps(1.0F);
+        for (; ii < SSE_END; ii += 4) {
+            const __m128 deviation = _mm_andnot_ps(sign4, _mm_sub_ps(_mm_loadu_ps(values + ii), center4));
+            count4 = _mm_add_ps(count4, _mm_and_ps(_mm_cmplt_ps(deviation, radius4), one4));
+        }
+        count4 = _mm_add_ps(count4, _mm_movehl_ps(count4, count4));
+        count4 = _mm_add_ss(count4, _mm_shuffle_ps(count4, count4, 1));
+        count = static_cast<uint32_t>(_mm_cvtss_f32(count4));
+#endif
+        for (; ii < Count; ++ii) {
+            count += std::fabs(values[ii] - center) < radius ? 1U : 0U;
+        }
+        return count;
+    }
+};
+
+
+/*!
+Lane traits for the templated filters in filter_templates.h, which hold their state as `lanes_t` rather than `T`.
+
+The default traits hold the state as `T` and filter using the arithmetic operators of `T`.
+Specialize `FilterLaneTraits` to hold the state of another type in a form that is faster to filter: `lanes_t` must support
+`lanes_t + lanes_t`, `lanes_t - lanes_t` and `lanes_t*float`, and be zero when value-initialized.
+
+3 and 4 component float vectors can be opted in to being filtered in a single SIMD register by deriving from `FilterVectorLaneTraits`, eg
+    template <> struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+The specialization must be visible wherever the filters are used with that type, so it is best placed in the header that defines the type.
+*/
+template <typename T>
+struct FilterLaneTraits {
+    using lanes_t = T;
+    static const T& to_lanes(const T& value) { return value; }
+    static const T& from_lanes(const lanes_t& lanes) { return lanes; }
+};
+
+//! A vector of three floats `x`, `y` and `z`, such as `xyz_t`.
+template <typename T>
+concept FilterVector3 = std::is_same_v<decltype(T::x), float> && std::is_same_v<decltype(T::y), float> && std::is_same_v<decltype(T::z), float>;
+//! A vector of four floats `x`, `y`, `z` and `w`.
+template <typename T>
+concept FilterVector4 = FilterVector3<T> && std::is_same_v<decltype(T::w), float>;
+
+#if defined(LIBRARY_FILTER_SIMD_SSE) || defined(LIBRARY_FILTER_SIMD_NEON)
+/*!
+Four floats held in a single SSE or NEON register.
+*/
+struct FilterLanes4 {
+#if defined(LIBRARY_FILTER_SIMD_SSE)
+    __m128 v;
+    static FilterLanes4 set(float x, float y, float z, float w) { return FilterLanes4 { _mm_setr_ps(x, y, z, w) }; }
+    void get(std::array<float, 4>& values) const { _mm_storeu_ps(&values[0], v); }
+    friend FilterLanes4 operator+(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { _mm_add_ps(a.v, b.v) }; }
+    friend FilterLanes4 operator-(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { _mm_sub_ps(a.v, b.v) }; }
+    friend FilterLanes4 operator*(const FilterLanes4& a, float k) { return FilterLanes4 { _mm_mul_ps(a.v, _mm_set1_ps(k)) }; }
+    friend FilterLanes4 operator*(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { _mm_mul_ps(a.v, b.v) }; } //!< lane by lane product
+    //! Sets lanes whose magnitude is less than `threshold` to zero, see FilterDenormal.
+    void flush_below(float threshold) {
+        const __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0F), v);
+        v = _mm_and_ps(v, _mm_cmpge_ps(magnitude, _mm_set1_ps(threshold)));
+    }
+#else
+    float32x4_t v;
+    static FilterLanes4 set(float x, float y, float z, float w) { const std::array<float, 4> values { x, y, z, w }; return FilterLanes4 { vld1q_f32(&values[0]) }; }
+    void get(std::array<float, 4>& values) const { vst1q_f32(&values[0], v); }
+    friend FilterLanes4 operator+(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { vaddq_f32(a.v, b.v) }; }
+    friend FilterLanes4 operator-(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { vsubq_f32(a.v, b.v) }; }
+    friend FilterLanes4 operator*(const FilterLanes4& a, float k) { return FilterLanes4 { vmulq_n_f32(a.v, k) }; }
+    friend FilterLanes4 operator*(const FilterLanes4& a, const FilterLanes4& b) { return FilterLanes4 { vmulq_f32(a.v, b.v) }; } //!< lane by lane product
+    //! Sets lanes whose magnitude is less than `threshold` to zero, see FilterDenormal.
+    void flush_below(float threshold) {
+        const uint32x4_t mask = vcgeq_f32(vabsq_f32(v), vdupq_n_f32(threshold));
+        v = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), mask));
+    }
+#endif
+};
+
+/*!
+Lane traits for 3 and 4 component vectors, which are padded to four lanes so that all the components are filtered in a single SIMD register.
+Used by specializing `FilterLaneTraits`, see above.
+*/
+template <typename T>
+requires FilterVector3<T>
+struct FilterVectorLaneTraits {
+    using lanes_t = FilterLanes4;
+    static lanes_t to_lanes(const T& value) {
+        if constexpr (FilterVector4<T>) {
+            return lanes_t::set(value.x, value.y, value.z, value.w);
+        } else {
+            return lanes_t::set(value.x, value.y, value.z, 0.0F);
+        }
+    }
+    static T from_lanes(const lanes_t& lanes) {
+        std::array<float, 4> values {};
+        lanes.get(values);
+        T value {};
+        value.x = values[0];
+        value.y = values[1];
+        value.z = values[2];
+        if constexpr (FilterVector4<T>) {
+            value.w = values[3];
+        }
+        return value;
+    }
+};
+#else
+//! Without SIMD the vector is held as itself, as by the default `FilterLaneTraits`.
+template <typename T>
+requires FilterVector3<T>
+struct FilterVectorLaneTraits {
+    using lanes_t = T;
+    static const T& to_lanes(const T& value) { return value; }
+    static const T& from_lanes(const lanes_t& lanes) { return lanes; }
+};
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+
+/*!
+Accumulation policies for running sums that have items both added and subtracted, as used by `RollingBufferWithSum` and `FilterMovingAverage`.
+
+Each policy provides `add(value)`, `subtract(value)`, `sum()` and `reset()`, and defines `sum_t`, the type returned by `sum()`.
+
+`SumPlain<T>`       adds and subtracts in `T`. Fastest, but for floating point `T` each operation rounds, so over a long run
+                    the sum drifts from the true sum of the items in a random walk.
+`SumNeumaier<T>`    Neumaier's improved Kahan summation, for floating point `T`. The rounding error of each operation is captured
+                    and accumulated in a separate compensation term, so the sum stays within a few ulp of the true sum
+                    however long it runs. Costs about four extra additions and a comparison per operation.
+`SumInteger<T>`     for integer `T`, accumulates in a 64 bit integer, so the sum is exact and cannot overflow for 32 bit or smaller `T`.
+*/
+template <typename T>
+struct SumPlain {
+    using sum_t = T;
+    void add(const T& value) { _sum += value; }
+    void subtract(const T& value) { _sum -= value; }
+    sum_t sum() const { return _sum; }
+    void reset() { _sum = sum_t {}; }
+private:
+    sum_t _sum {};
+};
+
+template <typename T>
+struct SumNeumaier {
+    static_assert(std::is_floating_point_v<T>, "SumNeumaier requires a floating point type");
+    using sum_t = T;
+    void add(T value) {
+        const T sum = _sum + value;
+        // the rounding error of the addition, calculated from whichever operand is larger in magnitude
+        _compensation += (std::fabs(_sum) >= std::fabs(value)) ? (_sum - sum) + value : (value - sum) + _sum;
+        _sum = sum;
+    }
+    void subtract(T value) { add(-value); }
+    sum_t sum() const { return _sum + _compensation; }
+    void reset() { _sum = T {}; _compensation = T {}; }
+private:
+    T _sum {};
+    T _compensation {};
+};
+
+template <typename T>
+struct SumInteger {
+    static_assert(std::is_integral_v<T>, "SumInteger requires an integer type");
+    static_assert(sizeof(T) <= 4, "SumInteger requires a 32 bit or smaller integer type");
+    using sum_t = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+    void add(T value) { _sum += static_cast<sum_t>(value); }
+    void subtract(T value) { _sum -= static_cast<sum_t>(value); }
+    sum_t sum() const { return _sum; }
+    void reset() { _sum = 0; }
+private:
+    sum_t _sum {};
+};
@@ -5,9 +5,19 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "filter_denormal.h"
+#include "filter_simd.h"
+#include "filter_trig.h"
 
 /*!
 Templated variants of selected filters.
+
+The power transfer and biquad filters hold their state as `FilterLaneTraits<T>::lanes_t`, see filter_simd.h.
+On targets with SSE or NEON, 3 and 4 component vectors such as `xyz_t` whose `FilterLaneTraits` derive from `FilterVectorLaneTraits`
+are held in a single SIMD register, so all the components are filtered in one pass.
 */
 
 /*!
@@ -31,6 +41,7 @@ public:
 public:
     void init(float k) { (void)k; }
     void reset() {}
+    void reset_to(const T& value) { (void)value; }
     void set_to_passthrough() {}
     void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { (void)cutoff_frequency_hz; (void)dt; }
     void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { (void)cutoff_frequency_hz; (void)dt; }
@@ -46,38 +57,57 @@ First order power transfer filter
 */
 template <typename T>
 class PowerTransferFilter1T : public FilterBaseT<T> {
+public:
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
 public:
     explicit PowerTransferFilter1T(float k) : _k(k) {}
     PowerTransferFilter1T() : PowerTransferFilter1T(1.0F) {}
-    PowerTransferFilter1T(float cutoff_frequency_hz, float dt) : PowerTransferFilter1T(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter1T(float cutoff_frequency_hz, float dt) : PowerTransferFilter1T(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
-    void reset() { _state = {}; }
-    void set_to_passthrough() { _k = 1.0F; reset(); }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
+    void reset() { _state = lanes_t {}; }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(const T& value) { _state = traits_t::to_lanes(value); }
+    void flush_denormals() { FilterDenormal::flush(_state); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; reset(); }
 
     T filter(const T& input) {
-        _state = _state + (input - _state)*_k; // equivalent to _state = _k*input + (1.0F - _k)*_state;
-        return _state;
+        _state = _state + (traits_t::to_lanes(input) - _state)*_k; // equivalent to _state = _k*input + (1.0F - _k)*_state;
+        return traits_t::from_lanes(_state);
+    }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    T filter_variable_dt(const T& input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = gain_from_omega(_omega*dt);
+        return filter(input);
     }
     virtual T filter_virtual(const T& input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     // Calculates filter gain based on delay (time constant of filter) - time it takes for filter response to reach 63.2% of a step input.
     static float gain_from_delay(float delay, float dt) {
         if (delay <= 0) { return 1.0F; } // gain of 1.0F means no filtering
         const float omega = dt/delay;
         return omega/(omega + 1.0F);
     }
-    static float gain_from_frequency(float cutoff_frequency_hz, float dt) {
-        const float omega = 2.0F*PI_F*cutoff_frequency_hz*dt;
-        return omega/(omega + 1.0F);
-    }
+    static float gain_from_frequency(float cutoff_frequency_hz, float dt) { return gain_from_omega(omega_from_frequency(cutoff_frequency_hz)*dt); }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return 2.0F*PI_F*cutoff_frequency_hz; }
+    static float gain_from_omega(float omega_dt) { return omega_dt/(omega_dt + 1.0F); }
 // for testing
-    const T& get_state() const { return _state; }
+    //! Returns a reference to the state when it is held as `T`, and a copy when it is held in lanes, see `FilterLaneTraits`.
+    decltype(auto) get_state() const {
+        if constexpr (std::is_same_v<lanes_t, T>) {
+            return (_state);
+        } else {
+            return traits_t::from_lanes(_state);
+        }
+    }
 protected:
     float _k;
-    T _state {};
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
+    lanes_t _state {};
 protected:
     static constexpr float PI_F = 3.14159265358979323846F;
 };
@@ -88,24 +118,36 @@ Second order power transfer filter
 */
 template <typename T>
 class PowerTransferFilter2T : public FilterBaseT<T> {
+public:
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
 public:
     explicit PowerTransferFilter2T(float k) : _k(k) {}
     PowerTransferFilter2T() : PowerTransferFilter2T(1.0F) {}
-    PowerTransferFilter2T(float cutoff_frequency_hz, float dt) : PowerTransferFilter2T(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter2T(float cutoff_frequency_hz, float dt) : PowerTransferFilter2T(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
-    void reset() { _state[0] = {}; _state[1] = {}; }
-    void set_to_passthrough() { _k = 1.0F; }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
+    void reset() { _state[0] = lanes_t {}; _state[1] = lanes_t {}; }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(const T& value) { _state[0] = traits_t::to_lanes(value); _state[1] = _state[0]; }
+    void flush_denormals() { FilterDenormal::flush(_state[0]); FilterDenormal::flush(_state[1]); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; }
 
     T filter(const T& input) {
-        _state[1] = _state[1] + (input - _state[1])*_k;
+        _state[1] = _state[1] + (traits_t::to_lanes(input) - _state[1])*_k;
         _state[0] = _state[0] + (_state[1] - _state[0])*_k;
-        return _state[0];
+        return traits_t::from_lanes(_state[0]);
+    }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    T filter_variable_dt(const T& input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt);
+        return filter(input);
     }
     virtual T filter_virtual(const T& input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     static float gain_from_delay(float delay, float dt) {
         return PowerTransferFilter1T<T>::gain_from_delay(delay*CUTOFF_CORRECTION, dt);
     }
@@ -113,13 +155,22 @@ public:
         // shift cutoffFrequency to satisfy -3dB cutoff condition
         return PowerTransferFilter1T<T>::gain_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION, dt);
     }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return PowerTransferFilter1T<T>::omega_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION); }
 // for testing
-    const std::array<T, 2>& get_state() const { return _state; }
+    //! Returns a reference to the state when it is held as `T`, and a copy when it is held in lanes, see `FilterLaneTraits`.
+    decltype(auto) get_state() const {
+        if constexpr (std::is_same_v<lanes_t, T>) {
+            return (_state);
+        } else {
+            return std::array<T, 2> {{ traits_t::from_lanes(_state[0]), traits_t::from_lanes(_state[1]) }};
+        }
+    }
 protected:
     // PowerTransferFilter<n> cutoff correction = 1/sqrt(2^(1/n) - 1)
     static constexpr float CUTOFF_CORRECTION = 1.553773974F;
     float _k;
-    std::array<T, 2> _state {};
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency*CUTOFF_CORRECTION, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
+    std::array<lanes_t, 2> _state {};
 };
 
 
@@ -128,25 +179,37 @@ Third order power transfer filter
 */
 template <typename T>
 class PowerTransferFilter3T : public FilterBaseT<T> {
+public:
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
 public:
     explicit PowerTransferFilter3T(float k) : _k(k) {}
     PowerTransferFilter3T() : PowerTransferFilter3T(1.0F) {}
-    PowerTransferFilter3T(float cutoff_frequency_hz, float dt) : PowerTransferFilter3T(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter3T(float cutoff_frequency_hz, float dt) : PowerTransferFilter3T(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
-    void reset() { _state[0] = {}; _state[1] = {}; _state[2] = {}; }
-    void set_to_passthrough() { _k = 1.0F; reset(); }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
+    void reset() { _state[0] = lanes_t {}; _state[1] = lanes_t {}; _state[2] = lanes_t {}; }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(const T& value) { _state[0] = traits_t::to_lanes(value); _state[1] = _state[0]; _state[2] = _state[0]; }
+    void flush_denormals() { FilterDenormal::flush(_state[0]); FilterDenormal::flush(_state[1]); FilterDenormal::flush(_state[2]); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; reset(); }
 
     T filter(const T& input) {
-        _state[2] = _state[2] + (input - _state[2])*_k;
+        _state[2] = _state[2] + (traits_t::to_lanes(input) - _state[2])*_k;
         _state[1] = _state[1] + (_state[2] - _state[1])*_k;
         _state[0] = _state[0] + (_state[1] - _state[0])*_k;
-        return _state[0];
+        return traits_t::from_lanes(_state[0]);
+    }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    T filter_variable_dt(const T& input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt);
+        return filter(input);
     }
     virtual T filter_virtual(const T& input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     static float gain_from_delay(float delay, float dt) {
         return PowerTransferFilter1T<T>::gain_from_delay(delay*CUTOFF_CORRECTION, dt);
     }
@@ -154,13 +217,133 @@ public:
         // shift cutoffFrequency to satisfy -3dB cutoff condition
         return PowerTransferFilter1T<T>::gain_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION, dt);
     }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return PowerTransferFilter1T<T>::omega_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION); }
 // for testing
-    const std::array<T, 3>& get_state() const { return _state; }
+    //! Returns a reference to the state when it is held as `T`, and a copy when it is held in lanes, see `FilterLaneTraits`.
+    decltype(auto) get_state() const {
+        if constexpr (std::is_same_v<lanes_t, T>) {
+            return (_state);
+        } else {
+            return std::array<T, 3> {{ traits_t::from_lanes(_state[0]), traits_t::from_lanes(_state[1]), traits_t::from_lanes(_state[2]) }};
+        }
+    }
 protected:
     // PowerTransferFilter<n> cutoff correction = 1/sqrt(2^(1/n) - 1)
     static constexpr float CUTOFF_CORRECTION = 1.961459177F;
     float _k;
-    std::array<T, 3> _state {};
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency*CUTOFF_CORRECTION, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
+    std::array<lanes_t, 3> _state {};
+};
+
+
+/*!
+Cutoff correction `1/sqrt(2^(1/order) - 1)` for a power transfer filter of order `order`, calculated at compile time.
+Both roots are found by Newton's method, starting above the root so that the iterations decrease monotonically onto it.
+*/
+constexpr float power_transfer_cutoff_correction(size_t order)
+{
+    double root_of_two = 2.0;
+    for (int ii = 0; ii < 64; ++ii) {
+        double power = 1.0; // root_of_two^(order - 1)
+        for (size_t jj = 1; jj < order; ++jj) {
+            power *= root_of_two;
+        }
+        root_of_two -= (power*root_of_two - 2.0)/(static_cast<double>(order)*power);
+    }
+    const double value = root_of_two - 1.0; // in (0, 1], so its square root is at most 1
+    double square_root = 1.0;
+    for (int ii = 0; ii < 64; ++ii) {
+        square_root = 0.5*(square_root + value/square_root);
+    }
+    return static_cast<float>(1.0/square_root);
+}
+
+
+/*!
+Power transfer filter of any order, `Order` first order stages in series.
+
+`PowerTransferFilterN<2>` and `PowerTransferFilterN<3>` give the same output as `PowerTransferFilter2T` and `PowerTransferFilter3T`.
+The cutoff correction `1/sqrt(2^(1/Order) - 1)`, which places the -3dB point of the whole filter at the cutoff frequency,
+is calculated at compile time, and the stages are unrolled at compile time, so there is no loop over the stages.
+
+`filter_block()` streams a whole buffer through all the stages, holding the state in local variables for the duration of the block.
+*/
+template <size_t Order, typename T = float>
+class PowerTransferFilterN : public FilterBaseT<T> {
+public:
+    static_assert(Order >= 1 && Order <= 8, "Order must be in the range [1, 8]");
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
+    using state_t = std::array<lanes_t, Order>;
+public:
+    explicit PowerTransferFilterN(float k) : _k(k) {}
+    PowerTransferFilterN() : PowerTransferFilterN(1.0F) {}
+    PowerTransferFilterN(float cutoff_frequency_hz, float dt) : PowerTransferFilterN(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
+public:
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
+    void reset() { _state.fill(lanes_t {}); }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(const T& value) { _state.fill(traits_t::to_lanes(value)); }
+    void flush_denormals() { for (auto& state : _state) { FilterDenormal::flush(state); } } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; reset(); }
+
+    T filter(const T& input) { return traits_t::from_lanes(filter_stages(_state, traits_t::to_lanes(input), _k)); }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    T filter_variable_dt(const T& input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt);
+        return filter(input);
+    }
+    virtual T filter_virtual(const T& input) override { return filter(input); }
+    void filter_block(const T* input, T* output, size_t count) {
+        state_t state = _state;
+        const float k = _k;
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = traits_t::from_lanes(filter_stages(state, traits_t::to_lanes(input[ii]), k));
+        }
+        _state = state;
+    }
+    void filter_block(T* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = PowerTransferFilter1T<T>::gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
+    static float gain_from_delay(float delay, float dt) {
+        return PowerTransferFilter1T<T>::gain_from_delay(delay*CUTOFF_CORRECTION, dt);
+    }
+    static float gain_from_frequency(float cutoff_frequency_hz, float dt) {
+        // shift cutoffFrequency to satisfy -3dB cutoff condition
+        return PowerTransferFilter1T<T>::gain_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION, dt);
+    }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return PowerTransferFilter1T<T>::omega_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION); }
+    static constexpr size_t order() { return Order; }
+// for testing
+    //! Returns a reference to the state when it is held as `T`, and a copy when it is held in lanes, see `FilterLaneTraits`.
+    decltype(auto) get_state() const {
+        if constexpr (std::is_same_v<lanes_t, T>) {
+            return (_state);
+        } else {
+            std::array<T, Order> state {};
+            for (size_t ii = 0; ii < Order; ++ii) {
+                state[ii] = traits_t::from_lanes(_state[ii]);
+            }
+            return state;
+        }
+    }
+protected:
+    //! Filters `input` through all the stages, the input stage is `state[Order - 1]` and the output stage is `state[0]`, as for `PowerTransferFilter3T`.
+    static lanes_t filter_stages(state_t& state, lanes_t input, float k) {
+        return filter_stages(state, input, k, std::make_index_sequence<Order>{});
+    }
+    template <size_t... Is>
+    static lanes_t filter_stages(state_t& state, lanes_t input, float k, std::index_sequence<Is...>) {
+        ((input = state[Order - 1 - Is] = state[Order - 1 - Is] + (input - state[Order - 1 - Is])*k), ...);
+        return input;
+    }
+protected:
+    static constexpr float CUTOFF_CORRECTION = power_transfer_cutoff_correction(Order);
+    float _k;
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency*CUTOFF_CORRECTION, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
+    state_t _state {};
 };
 
 
@@ -172,6 +355,9 @@ Has additional `_weight` member data, which allows the filter to combine input a
 */
 template <typename T>
 class BiquadFilterT : public FilterBaseT<T> {
+public:
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
 public:
     BiquadFilterT(float a1, float a2, float b0, float b1, float b2) :
         _weight(1.0F),
@@ -179,12 +365,15 @@ public:
         _b0(b0), _b1(b1), _b2(b2)
         {}
     BiquadFilterT() : BiquadFilterT(0.0F, 0.0F, 1.0F, 0.0F, 0.0F) {}
-    struct state_t {
-        T x1;
-        T x2;
-        T y1;
-        T y2;
+    //! Direct form I state, held as `U`, which is `T` for `state_t` and `lanes_t` internally.
+    template <typename U>
+    struct direct_form_state_t {
+        U x1;
+        U x2;
+        U y1;
+        U y2;
     };
+    using state_t = direct_form_state_t<T>;
 public:
     void set_weight(float weight) { _weight = weight; }
     float get_weight() const { return _weight; }
@@ -209,25 +398,38 @@ public:
         _b2 = other._b2;
     }
 
-    void reset() { _state.x1 = {}; _state.x2 = {}; _state.y1 = {}; _state.y2 = {}; }
+    void reset() { _state.x1 = lanes_t {}; _state.x2 = lanes_t {}; _state.y1 = lanes_t {}; _state.y2 = lanes_t {}; }
+    //! Sets the state to the steady state for a constant input of `value`, the outputs are `value` times the DC gain, see `BiquadFilter::reset_to`.
+    void reset_to(const T& value) {
+        const lanes_t input = traits_t::to_lanes(value);
+        const lanes_t output = input*get_dc_gain();
+        _state.x1 = input; _state.x2 = input; _state.y1 = output; _state.y2 = output;
+    }
+    float get_dc_gain() const { return (_b0 + _b1 + _b2)/(1.0F + _a1 + _a2); }
+    void flush_denormals() { FilterDenormal::flush(_state.x1); FilterDenormal::flush(_state.x2); FilterDenormal::flush(_state.y1); FilterDenormal::flush(_state.y2); } //!< see FilterDenormal
     void set_to_passthrough() { _b0 = 1.0F; _b1 = 0.0F; _b2 = 0.0F; _a1 = 0.0F; _a2 = 0.0F;  _weight = 1.0F; reset(); }
 
-    T filter(const T& input) {
-        const T output = input*_b0 + _state.x1*_b1 + _state.x2*_b2 - _state.y1*_a1 - _state.y2*_a2;
+    T filter(const T& input) { return traits_t::from_lanes(filter_lanes(traits_t::to_lanes(input))); }
+    virtual T filter_virtual(const T& input) override { return filter(input); }
+    T filter_weighted(const T& input) { return traits_t::from_lanes(filter_weighted_lanes(traits_t::to_lanes(input))); }
+
+    //! Filters input that has been converted using `traits_t::to_lanes`, so that filters can be chained without converting between them.
+    lanes_t filter_lanes(const lanes_t& input) {
+        const lanes_t output = input*_b0 + _state.x1*_b1 + _state.x2*_b2 - _state.y1*_a1 - _state.y2*_a2;
         _state.x2 = _state.x1;
         _state.x1 = input;
         _state.y2 = _state.y1;
         _state.y1 = output;
         return output;
     }
-    virtual T filter_virtual(const T& input) override { return filter(input); }
-
-    T filter_weighted(const T& input) {
-        const T output = filter(input);
+    lanes_t filter_weighted_lanes(const lanes_t& input) {
         // weight of 1.0 gives just output, weight of 0.0 gives just input
-        return (output - input)*_weight + input;
+        return (filter_lanes(input) - input)*_weight + input;
     }
 
+    void filter_block(const T* input, T* output, size_t count);
+    void filter_block(T* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
     void init_lowpass(float frequency_hz, float looptime_seconds, float q) {
         assert(q != 0.0F && "q cannot be zero");
         set_looptime(looptime_seconds);
@@ -245,9 +447,11 @@ public:
 
     float calculate_omega(float frequency) const { return frequency*_2_pi_looptime_seconds; }
 
+    template <typename TRIG = FilterTrig>
     void set_low_pass_frequencyWeighted(float frequency_hz, float weight);
     void set_low_pass_frequency(float frequency_hz) { set_low_pass_frequencyWeighted(frequency_hz, 1.0F); }
 
+    template <typename TRIG = FilterTrig>
     void set_notch_frequency_weighted(float frequency_hz, float weight); // assumes q already set
     void set_notch_frequency(float frequency_hz) {set_notch_frequency_weighted(frequency_hz, 1.0F); } // assumes q already set
     void set_notch_frequency_weighted(float sin_omega, float two_cos_omega, float weight);
@@ -268,8 +472,16 @@ public:
 
     void set_looptime(float looptime_seconds) { _2_pi_looptime_seconds = 2.0F*PI_F*looptime_seconds; }
 // for testing
-    const state_t& get_state() const { return _state; }
+    //! Returns a reference to the state when it is held as `T`, and a copy when it is held in lanes, see `FilterLaneTraits`.
+    decltype(auto) get_state() const {
+        if constexpr (std::is_same_v<lanes_t, T>) {
+            return (_state);
+        } else {
+            return state_t { traits_t::from_lanes(_state.x1), traits_t::from_lanes(_state.x2), traits_t::from_lanes(_state.y1), traits_t::from_lanes(_state.y2) };
+        }
+    }
 protected:
+    using lanes_state_t = direct_form_state_t<lanes_t>;
     float _weight {1.0F}; //<! weight of 1.0 gives just output, weight of 0.0 gives just input
     float _a1;
     float _a2;
@@ -277,7 +489,7 @@ protected:
     float _b1;
     float _b2;
 
-    state_t _state {};
+    lanes_state_t _state {};
 
     float _2q_reciprocal {1.0F}; // store 1/(2*q), since that is what is used in set_notch_frequency calculations
     float _2_pi_looptime_seconds {0.0F}; // store 2*PI*looptime_seconds, since that is what is used in calculations
@@ -287,22 +499,19 @@ protected:
 
 /*!
 Note: weight must be in range [0, 1].
+`TRIG` is the trigonometry policy used to calculate the coefficients, see filter_trig.h.
 */
 template <typename T>
+template <typename TRIG>
 inline void BiquadFilterT<T>::set_low_pass_frequencyWeighted(float frequency_hz, float weight)
 {
     _weight = weight;
 
     const float omega = frequency_hz*_2_pi_looptime_seconds;
-#if defined(LIBRARY_FILTER_USE_SINCOS)
     float sin_omega {};
     float cos_omega {};
-    sincosf(omega, &sin_omega, &cos_omega);
+    TRIG::sincos(omega, sin_omega, cos_omega);
     const float alpha = sin_omega*_2q_reciprocal;
-#else
-    const float cos_omega = cosf(omega);
-    const float alpha = sinf(omega)*_2q_reciprocal;
-#endif
     const float a0_reciprocal = 1.0F/(1.0F + alpha);
 
     _b1 = (1.0F - cos_omega)*a0_reciprocal;
@@ -314,22 +523,19 @@ inline void BiquadFilterT<T>::set_low_pass_frequencyWeighted(float frequency_hz,
 
 /*!
 Note: weight must be in range [0, 1].
+`TRIG` is the trigonometry policy used to calculate the coefficients, see filter_trig.h.
 */
 template <typename T>
+template <typename TRIG>
 inline void BiquadFilterT<T>::set_notch_frequency_weighted(float frequency_hz, float weight)
 {
     _weight = weight;
 
     const float omega = frequency_hz*_2_pi_looptime_seconds;
-#if defined(LIBRARY_FILTER_USE_SINCOS)
     float sin_omega {};
     float cos_omega {};
-    sincosf(omega, &sin_omega, &cos_omega);
+    TRIG::sincos(omega, sin_omega, cos_omega);
     const float alpha = sin_omega*_2q_reciprocal;
-#else
-    const float cos_omega = cosf(omega);
-    const float alpha = sinf(omega)*_2q_reciprocal;
-#endif
     const float a0_reciprocal = 1.0F/(1.0F + alpha);
 
     _b0 = a0_reciprocal;
@@ -357,24 +563,74 @@ inline void BiquadFilterT<T>::set_notch_frequency_weighted(float sin_omega, floa
     _a2 = (1.0F - alpha)*a0_reciprocal;
 }
 
+/*!
+Filters `count` samples from `input` into `output`, `input` and `output` may be the same buffer.
+
+Uses a modified transposed direct form II that carries three values from sample to sample, `s1`, `s2` and the previous output `y1`,
+all of which stay in registers for the whole block. The `-a1*y1` term is left out of `s1` and applied when the next output is calculated,
+so the recursive path from one output to the next is a single multiply and subtract.
+The direct form I state is converted on entry and restored on exit, so `filter()` and `filter_block()` may be freely interleaved.
+*/
+template <typename T>
+void BiquadFilterT<T>::filter_block(const T* input, T* output, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    // save the last two inputs, since they are overwritten when filtering in place
+    const lanes_t x1 = traits_t::to_lanes(input[count - 1]);
+    const lanes_t x2 = count > 1 ? traits_t::to_lanes(input[count - 2]) : _state.x1;
+
+    const float b0 = _b0;
+    const float b1 = _b1;
+    const float b2 = _b2;
+    const float a1 = _a1;
+    const float a2 = _a2;
+    // s1 is held without its -y1*a1 term, which is applied when the next output is calculated,
+    // this leaves a single multiply and subtract on the recursive path from one output to the next
+    const lanes_t y2 = _state.y1;
+    lanes_t y1 = _state.y1;
+    lanes_t s1 = _state.x1*b1 + _state.x2*b2 - _state.y2*a2;
+    lanes_t s2 = _state.x1*b2 - _state.y1*a2;
+    for (size_t ii = 0; ii < count; ++ii) {
+        const lanes_t x = traits_t::to_lanes(input[ii]);
+        const lanes_t y = x*b0 + s1 - y1*a1;
+        s1 = s2 + x*b1;
+        s2 = x*b2 - y*a2;
+        y1 = y;
+        output[ii] = traits_t::from_lanes(y);
+    }
+
+    _state.x1 = x1;
+    _state.x2 = x2;
+    _state.y1 = y1;
+    _state.y2 = count > 1 ? traits_t::to_lanes(output[count - 2]) : y2;
+}
+
 
 /*!
 Simple moving average filter.
+
+After `reset_to(value)` the window behaves as if it were full of `value`, without writing the samples, see `FilterMovingAverage`.
 */
 template <typename T, size_t N>
 class FilterMovingAverageT : public FilterBaseT<T> {
 public:
     FilterMovingAverageT() {} // cppcheck-suppress uninitMemberVar
 public:
-    void reset() { _sum = {}; _count = 0; _index = 0;}
+    void reset() { _sum = {}; _count = 0; _index = 0; _fill = {}; _warm = false; }
+    void reset_to(const T& value) { _sum = value*static_cast<float>(N); _count = 0; _index = 0; _fill = value; _warm = true; }
 
     T filter(const T& input);
     T filter(const T& input, float dt) { (void)dt; return filter(input); }
     virtual T filter_virtual(const T& input) override { return filter(input); }
 protected:
+    static constexpr float N_RECIPROCAL = 1.0F/static_cast<float>(N);
     size_t _count {0};
     size_t _index {0};
     T _sum {};
+    T _fill {}; //!< value that the first N samples displace from the sum, set by `reset_to()`
+    bool _warm {false}; //!< true after `reset_to()`, when the average is over the whole window while it fills
     T _samples[N];
 };
 
@@ -386,6 +642,10 @@ inline T FilterMovingAverageT<T, N>::filter(const T& input)
         _samples[_index] = input;
         ++_index;
         ++_count;
+        if (_warm) {
+            _sum = _sum - _fill;
+            return _sum*N_RECIPROCAL;
+        }
         return _sum*(1.0F/static_cast<float>(_count));
     }
     if (_index == N) {
@@ -394,6 +654,5 @@ inline T FilterMovingAverageT<T, N>::filter(const T& input)
     _sum = _sum - _samples[_index];
     _samples[_index] = input;
     ++_index;
-    static constexpr float N_RECIPROCAL = 1.0F/static_cast<float>(N);
     return _sum*N_RECIPROCAL;
 }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+/*!
+Trigonometry policies used when calculating filter coefficients.
+
+Each policy provides `sincos(x, sin_x, cos_x)`. Maximum absolute errors are for float arguments in the range [-PI, PI],
+the range used by filter coefficient calculations. Arguments outside this range are reduced to it first.
+
+`TrigLibm`          uses `sinf`/`cosf`, or `sincosf` if `LIBRARY_FILTER_USE_SINCOS` is defined, max error about 1 ulp.
+`TrigPolynomial`    uses minimax polynomials of degree 7 (sin) and 8 (cos), max error 1e-6.
+`TrigLookupTable`   uses linear interpolation in a 257 entry quarter wave table held in read-only memory, max error 5e-6.
+
+The policy used by the filters defaults to `TrigLibm`, define `LIBRARY_FILTER_USE_TRIG_POLYNOMIAL` or `LIBRARY_FILTER_USE_TRIG_LOOKUP_TABLE`
+to change it. Individual coefficient updates may also select a policy explicitly, eg `set_notch_frequency_weighted<TrigPolynomial>(frequency_hz, weight)`.
+*/
+struct TrigLibm {
+    static void sincos(float x, float& sin_x, float& cos_x) {
+#if defined(LIBRARY_FILTER_USE_SINCOS)
+        sincosf(x, &sin_x, &cos_x);
+#else
+        sin_x = sinf(x);
+        cos_x = cosf(x);
+#endif
+    }
+};
+
+/*!
+Reduces `x` to the range [0, PI/2], returning the signs of sin(x) and cos(x).
+*/
+struct TrigReduce {
+    static constexpr float PI_F = 3.14159265358979323846F;
+    static constexpr float HALF_PI_F = PI_F/2.0F;
+    static constexpr float TWO_PI_F = 2.0F*PI_F;
+    static constexpr float TWO_PI_RECIPROCAL_F = 1.0F/TWO_PI_F;
+
+    static float reduce(float x, float& sin_sign, float& cos_sign) {
+        if (x > PI_F || x < -PI_F) {
+            x -= TWO_PI_F*std::floor(x*TWO_PI_RECIPROCAL_F + 0.5F);
+        }
+        sin_sign = 1.0F;
+        if (x < 0.0F) {
+            x = -x;
+            sin_sign = -1.0F;
+        }
+        cos_sign = 1.0F;
+        if (x > HALF_PI_F) {
+            x = PI_F - x;
+            cos_sign = -1.0F;
+        }
+        return x;
+    }
+};
+
+struct TrigPolynomial {
+    static void sincos(float x, float& sin_x, float& cos_x) {
+        float sin_sign {};
+        float cos_sign {};
+        x = TrigReduce::reduce(x, sin_sign, cos_sign);
+        const float x2 = x*x;
+        // minimax coefficients for the range [0, PI/2]
+        sin_x = sin_sign*x*(0.99999661591F + x2*(-0.16664828382F + x2*(8.3063252271e-3F + x2*-1.8363653976e-4F)));
+        cos_x = cos_sign*(0.99999995347F + x2*(-0.49999905347F + x2*(4.1663584693e-2F + x2*(-1.3853704308e-3F + x2*2.3153931659e-5F))));
+    }
+};
+
+struct TrigLookupTable {
+    static constexpr size_t TABLE_INTERVALS = 256;
+    static void sincos(float x, float& sin_x, float& cos_x) {
+        float sin_sign {};
+        float cos_sign {};
+        x = TrigReduce::reduce(x, sin_sign, cos_sign);
+        sin_x = sin_sign*interpolate(x);
+        cos_x = cos_sign*interpolate(TrigReduce::HALF_PI_F - x);
+    }
+private:
+    //! sin(x) for x in the range [0, PI/2]
+    static float interpolate(float x) {
+        const float position = x*(static_cast<float>(TABLE_INTERVALS)/TrigReduce::HALF_PI_F);
+        // convert via int32_t, since float to int32_t conversion is a single instruction on most targets
+        const int32_t index_i = std::min(static_cast<int32_t>(position), static_cast<int32_t>(TABLE_INTERVALS - 1));
+        const float fraction = position - static_cast<float>(index_i);
+        const auto index = static_cast<size_t>(index_i);
+        return SIN_TABLE[index] + (SIN_TABLE[index + 1] - SIN_TABLE[index])*fraction;
+    }
+    static constexpr std::array<float, TABLE_INTERVALS + 1> make_sin_table() {
+        std::array<float, TABLE_INTERVALS + 1> table {};
+        for (size_t ii = 0; ii <= TABLE_INTERVALS; ++ii) {
+            // Taylor series evaluated in double precision at compile time
+            const double x = 3.14159265358979323846*static_cast<double>(ii)/static_cast<double>(2*TABLE_INTERVALS);
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 12; ++n) {
+                term *= -x*x/static_cast<double>((2*n)*(2*n + 1));
+                sum += term;
+            }
+            table[ii] = static_cast<float>(sum);
+        }
+        return table;
+    }
+    static const std::array<float, TABLE_INTERVALS + 1> SIN_TABLE;
+};
+
+inline constexpr std::array<float, TrigLookupTable::TABLE_INTERVALS + 1> TrigLookupTable::SIN_TABLE = TrigLookupTable::make_sin_table();
+
+#if defined(LIBRARY_FILTER_USE_TRIG_POLYNOMIAL)
+using FilterTrig = TrigPolynomial;
+#elif defined(LIBRARY_FILTER_USE_TRIG_LOOKUP_TABLE)
+using FilterTrig = TrigLookupTable;
+#else
+using FilterTrig = TrigLibm;
+#endif
@@ -2,9 +2,16 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <utility>
+
+#include "filter_denormal.h"
+#include "filter_simd.h"
+#include "filter_sum.h"
+#include "filter_trig.h"
 
 /*!
 Filter abstract base class.
@@ -25,6 +32,7 @@ public:
 public:
     void init(float k) { (void)k; }
     void reset() {}
+    void reset_to(float value) { (void)value; }
     void set_to_passthrough() {}
     void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { (void)cutoff_frequency_hz; (void)dt; }
     void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { (void)cutoff_frequency_hz; (void)dt; }
@@ -42,34 +50,66 @@ class PowerTransferFilter1 : public FilterBase {
 public:
     explicit PowerTransferFilter1(float k) : _k(k) {}
     PowerTransferFilter1() : PowerTransferFilter1(1.0F) {}
-    PowerTransferFilter1(float cutoff_frequency_hz, float dt) : PowerTransferFilter1(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter1(float cutoff_frequency_hz, float dt) : PowerTransferFilter1(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
     void reset() { _state = 0.0F; }
-    void set_to_passthrough() { _k = 1.0F; reset(); }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(float value) { _state = value; }
+    void flush_denormals() { FilterDenormal::flush(_state); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; reset(); }
 
     float filter(float input) {
         _state = _state + (input - _state)*_k; // equivalent to _state = _k*input + (1.0F - _k)*_state;
         return _state;
     }
+    /*!
+    Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, for loops whose time step varies.
+    Gives the same result as calling `set_cutoff_frequency(cutoff_frequency_hz, dt)` before `filter(input)`, but reuses the stored `2*PI*cutoff_frequency_hz`.
+    */
+    float filter_variable_dt(float input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = gain_from_omega(_omega*dt);
+        return filter(input);
+    }
+    /*!
+    Filters `input` `count` times, in O(log count) operations, eg to catch up after samples have been dropped.
+    The state decays towards the input by `(1 - k)` each sample, so after `count` samples `state = input + (state - input)*(1 - k)^count`.
+    */
+    float advance(float input, size_t count) {
+        _state = input + (_state - input)*power(1.0F - _k, count);
+        return _state;
+    }
     virtual float filter_virtual(float input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     // Calculates filter gain based on delay (time constant of filter) - time it takes for filter response to reach 63.2% of a step input.
     static float gain_from_delay(float delay, float dt) {
         if (delay <= 0) { return 1.0F; } // gain of 1.0F means no filtering
         const float omega = dt/delay;
         return omega/(omega + 1.0F);
     }
-    static float gain_from_frequency(float cutoff_frequency_hz, float dt) {
-        const float omega = 2.0F*PI_F*cutoff_frequency_hz*dt;
-        return omega/(omega + 1.0F);
+    static float gain_from_frequency(float cutoff_frequency_hz, float dt) { return gain_from_omega(omega_from_frequency(cutoff_frequency_hz)*dt); }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return 2.0F*PI_F*cutoff_frequency_hz; }
+    static float gain_from_omega(float omega_dt) { return omega_dt/(omega_dt + 1.0F); }
+    //! `base^exponent` by repeated squaring.
+    static float power(float base, size_t exponent) {
+        float result = 1.0F;
+        while (exponent > 0) {
+            if (exponent & 1U) { result *= base; }
+            base *= base;
+            exponent >>= 1U;
+        }
+        return result;
     }
+    //! Sets the state, eg to continue from a state saved with `get_state()`.
+    void set_state(float state) { _state = state; }
 // for testing
     float get_state() const { return _state; }
 protected:
     float _k;
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
     float _state {};
 protected:
     static constexpr float PI_F = 3.14159265358979323846F;
@@ -83,21 +123,45 @@ class PowerTransferFilter2 : public FilterBase {
 public:
     explicit PowerTransferFilter2(float k) : _k(k) {}
     PowerTransferFilter2() : PowerTransferFilter2(1.0F) {}
-    PowerTransferFilter2(float cutoff_frequency_hz, float dt) : PowerTransferFilter2(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter2(float cutoff_frequency_hz, float dt) : PowerTransferFilter2(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
     void reset() { _state[0] = 0.0F; _state[1] = 0.0F; }
-    void set_to_passthrough() { _k = 1.0F; }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(float value) { _state[0] = value; _state[1] = value; }
+    void flush_denormals() { FilterDenormal::flush(_state[0]); FilterDenormal::flush(_state[1]); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; }
 
     float filter(float input) {
         _state[1] = _state[1] + (input - _state[1])*_k;
         _state[0] = _state[0] + (_state[1] - _state[0])*_k;
         return _state[0];
     }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    float filter_variable_dt(float input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = PowerTransferFilter1::gain_from_omega(_omega*dt);
+        return filter(input);
+    }
+    /*!
+    Filters `input` `count` times, in O(log count) operations, eg to catch up after samples have been dropped.
+    Both stages decay towards the input by `a = 1 - k` each sample, so after `n` samples the errors from the input are
+        e1[n] = a^n*e1
+        e0[n] = a^n*(e0 + n*k*e1)
+    */
+    float advance(float input, size_t count) {
+        const float decay = PowerTransferFilter1::power(1.0F - _k, count);
+        const float nk = static_cast<float>(count)*_k;
+        const float e1 = _state[1] - input;
+        const float e0 = _state[0] - input;
+        _state[1] = input + e1*decay;
+        _state[0] = input + (e0 + nk*e1)*decay;
+        return _state[0];
+    }
     virtual float filter_virtual(float input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = PowerTransferFilter1::gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     static float gain_from_delay(float delay, float dt) {
         return PowerTransferFilter1::gain_from_delay(delay*CUTOFF_CORRECTION, dt);
     }
@@ -105,12 +169,16 @@ public:
         // shift cutoffFrequency to satisfy -3dB cutoff condition
         return PowerTransferFilter1::gain_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION, dt);
     }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return PowerTransferFilter1::omega_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION); }
+    //! Sets the state, eg to continue from a state saved with `get_state()`.
+    void set_state(const std::array<float, 2>& state) { _state = state; }
 // for testing
     const std::array<float, 2>& get_state() const { return _state; }
 protected:
     // PowerTransferFilter<n> cutoff correction = 1/sqrt(2^(1/n) - 1)
     static constexpr float CUTOFF_CORRECTION = 1.553773974F;
     float _k;
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency*CUTOFF_CORRECTION, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
     std::array<float, 2> _state {};
 };
 
@@ -122,11 +190,14 @@ class PowerTransferFilter3 : public FilterBase {
 public:
     explicit PowerTransferFilter3(float k) : _k(k) {}
     PowerTransferFilter3() : PowerTransferFilter3(1.0F) {}
-    PowerTransferFilter3(float cutoff_frequency_hz, float dt) : PowerTransferFilter3(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+    PowerTransferFilter3(float cutoff_frequency_hz, float dt) : PowerTransferFilter3(1.0F) { set_cutoff_frequency(cutoff_frequency_hz, dt); }
 public:
-    void init(float k) { _k = k; reset(); }
+    void init(float k) { _k = k; _omega = 0.0F; reset(); }
     void reset() { _state[0] = 0.0F; _state[1] = 0.0F; _state[2] = 0.0F; }
-    void set_to_passthrough() { _k = 1.0F; reset(); }
+    //! Sets the state to the steady state for a constant input of `value`, so the output starts at `value` without a startup transient.
+    void reset_to(float value) { _state[0] = value; _state[1] = value; _state[2] = value; }
+    void flush_denormals() { FilterDenormal::flush(_state[0]); FilterDenormal::flush(_state[1]); FilterDenormal::flush(_state[2]); } //!< see FilterDenormal
+    void set_to_passthrough() { _k = 1.0F; _omega = 0.0F; reset(); }
 
     float filter(float input) {
         _state[2] = _state[2] + (input - _state[2])*_k;
@@ -134,10 +205,34 @@ public:
         _state[0] = _state[0] + (_state[1] - _state[0])*_k;
         return _state[0];
     }
+    //! Filters with the gain for the time step `dt` and the cutoff frequency set by `set_cutoff_frequency()`, see `PowerTransferFilter1::filter_variable_dt()`.
+    float filter_variable_dt(float input, float dt) {
+        assert(_omega > 0.0F && "cutoff frequency must be set by set_cutoff_frequency()");
+        _k = PowerTransferFilter1::gain_from_omega(_omega*dt);
+        return filter(input);
+    }
+    /*!
+    Filters `input` `count` times, in O(log count) operations, eg to catch up after samples have been dropped.
+    All the stages decay towards the input by `a = 1 - k` each sample, so after `n` samples the errors from the input are
+        e2[n] = a^n*e2
+        e1[n] = a^n*(e1 + n*k*e2)
+        e0[n] = a^n*(e0 + n*k*e1 + n*(n + 1)/2*k^2*e2)
+    */
+    float advance(float input, size_t count) {
+        const float decay = PowerTransferFilter1::power(1.0F - _k, count);
+        const float nk = static_cast<float>(count)*_k;
+        const float e2 = _state[2] - input;
+        const float e1 = _state[1] - input;
+        const float e0 = _state[0] - input;
+        _state[2] = input + e2*decay;
+        _state[1] = input + (e1 + nk*e2)*decay;
+        _state[0] = input + (e0 + nk*e1 + 0.5F*nk*(nk + _k)*e2)*decay;
+        return _state[0];
+    }
     virtual float filter_virtual(float input) override { return filter(input); }
 
-    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); }
-    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { _k = gain_from_frequency(cutoff_frequency_hz, dt); reset(); }
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _omega = omega_from_frequency(cutoff_frequency_hz); _k = PowerTransferFilter1::gain_from_omega(_omega*dt); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
     static float gain_from_delay(float delay, float dt) {
         return PowerTransferFilter1::gain_from_delay(delay*CUTOFF_CORRECTION, dt);
     }
@@ -145,16 +240,32 @@ public:
         // shift cutoffFrequency to satisfy -3dB cutoff condition
         return PowerTransferFilter1::gain_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION, dt);
     }
+    static float omega_from_frequency(float cutoff_frequency_hz) { return PowerTransferFilter1::omega_from_frequency(cutoff_frequency_hz*CUTOFF_CORRECTION); }
+    //! Sets the state, eg to continue from a state saved with `get_state()`.
+    void set_state(const std::array<float, 3>& state) { _state = state; }
 // for testing
     const std::array<float, 3>& get_state() const { return _state; }
 protected:
     // PowerTransferFilter<n> cutoff correction = 1/sqrt(2^(1/n) - 1)
     static constexpr float CUTOFF_CORRECTION = 1.961459177F;
     float _k;
+    float _omega {0.0F}; //!< 2*PI*cutoff frequency*CUTOFF_CORRECTION, used by `filter_variable_dt()`, zero if the gain was set by `init(k)`
     std::array<float, 3> _state {};
 };
 
 
+/*!
+Biquad filter coefficients, normalized so that a0 == 1.
+*/
+struct biquad_coefficients_t {
+    float a1;
+    float a2;
+    float b0;
+    float b1;
+    float b2;
+};
+
+
 /*!
 Biquad filter, see https://en.wikipedia.org/wiki/Digital_biquad_filter
 
@@ -189,6 +300,9 @@ public:
     void set_parameters(float a1, float a2, float b0, float b1, float b2) {
         set_parameters(a1, a2, b0, b1, b2, 1.0F);
     }
+    void set_parameters(const biquad_coefficients_t& coefficients) {
+        set_parameters(coefficients.a1, coefficients.a2, coefficients.b0, coefficients.b1, coefficients.b2, 1.0F);
+    }
     //! Copy parameters from another Biquad filter
     void set_parameters(const BiquadFilter& other) {
         _weight = other._weight;
@@ -198,8 +312,19 @@ public:
         _b1 = other._b1;
         _b2 = other._b2;
     }
+    biquad_coefficients_t get_parameters() const { return biquad_coefficients_t { _a1, _a2, _b0, _b1, _b2 }; }
 
     void reset() { _state.x1 = 0.0F; _state.x2 = 0.0F; _state.y1 = 0.0F; _state.y2 = 0.0F; }
+    /*!
+    Sets the state to the steady state for a constant input of `value`, so there is no startup transient.
+    The inputs are `value` and the outputs are `value` times the DC gain `(b0 + b1 + b2)/(1 + a1 + a2)`, which is finite for any stable filter.
+    */
+    void reset_to(float value) {
+        const float output = value*get_dc_gain();
+        _state.x1 = value; _state.x2 = value; _state.y1 = output; _state.y2 = output;
+    }
+    float get_dc_gain() const { return (_b0 + _b1 + _b2)/(1.0F + _a1 + _a2); }
+    void flush_denormals() { FilterDenormal::flush(_state.x1); FilterDenormal::flush(_state.x2); FilterDenormal::flush(_state.y1); FilterDenormal::flush(_state.y2); } //!< see FilterDenormal
     void set_to_passthrough() { _b0 = 1.0F; _b1 = 0.0F; _b2 = 0.0F; _a1 = 0.0F; _a2 = 0.0F;  _weight = 1.0F; reset(); }
 
     float filter(float input) {
@@ -212,12 +337,74 @@ public:
     }
     virtual float filter_virtual(float input) override { return filter(input); }
 
+    /*!
+    Filters `input` `count` times, giving the same state and output as `count` calls to `filter(input)`, in O(log count) operations,
+    eg to catch up after samples have been dropped. The output is not weighted.
+
+    After the first two samples the input history is constant, so the output obeys `y[n] = -a1*y[n-1] - a2*y[n-2] + c`, with `c = (b0 + b1 + b2)*input`.
+    That is `(y1, y2) -> A*(y1, y2) + (c, 0)`, where `A = [[-a1, -a2], [1, 0]]` is the companion matrix of the filter.
+    By the Cayley-Hamilton theorem `A*A = -a1*A - a2*I`, so any polynomial in `A` is `p*A + q*I` and is held as just the pair `(p, q)`,
+    and `A^n` is calculated by repeated squaring, in double, since for low cutoff frequencies `p` and `q` are large and nearly cancel.
+
+    The fixed point of the recursion is `y = c/(1 + a1 + a2)`, so after `n` samples
+        (y1, y2) -> y + A^n*((y1, y2) - y)
+    If `1 + a1 + a2` is zero there is no fixed point, and instead
+        (y1, y2) -> A^n*(y1, y2) + S*(c, 0), where S = I + A + ... + A^(n-1)
+    which is calculated alongside `A^n`. This form is not used otherwise, since for poles near `z = 1` the terms of `S*(c, 0)` cancel badly.
+    */
+    float advance(float input, size_t count) {
+        // filter until the input history holds only the input, at most two samples
+        for (; count > 0 && (_state.x1 != input || _state.x2 != input); --count) {
+            filter(input);
+        }
+        struct polynomial_t { double p; double q; }; // p*A + q*I
+        const double a1 = static_cast<double>(_a1);
+        const double a2 = static_cast<double>(_a2);
+        const auto multiply = [a1, a2](const polynomial_t& u, const polynomial_t& v) {
+            return polynomial_t { u.p*v.q + u.q*v.p - a1*u.p*v.p, u.q*v.q - a2*u.p*v.p };
+        };
+        const auto add = [](const polynomial_t& u, const polynomial_t& v) { return polynomial_t { u.p + v.p, u.q + v.q }; };
+        const double c = static_cast<double>((_b0 + _b1 + _b2)*input);
+        const double denominator = 1.0 + a1 + a2;
+        const bool has_fixed_point = denominator != 0.0;
+
+        polynomial_t power { 0.0, 1.0 }; // A^n
+        polynomial_t sum { 0.0, 0.0 }; // I + A + ... + A^(n-1), only needed without a fixed point
+        polynomial_t base_power { 1.0, 0.0 }; // A^(2^i)
+        polynomial_t base_sum { 0.0, 1.0 }; // I + A + ... + A^(2^i - 1)
+        while (count > 0) {
+            if (count & 1U) {
+                if (!has_fixed_point) {
+                    sum = add(sum, multiply(power, base_sum));
+                }
+                power = multiply(power, base_power);
+            }
+            if (!has_fixed_point) {
+                base_sum = add(base_sum, multiply(base_power, base_sum));
+            }
+            base_power = multiply(base_power, base_power);
+            count >>= 1U;
+        }
+        const double fixed_point = has_fixed_point ? c/denominator : 0.0;
+        const double e1 = static_cast<double>(_state.y1) - fixed_point;
+        const double e2 = static_cast<double>(_state.y2) - fixed_point;
+        // A^n*(e1, e2) + S*(c, 0)
+        const double y1 = (power.q - power.p*a1)*e1 - power.p*a2*e2 + (sum.q - sum.p*a1)*c;
+        const double y2 = power.p*e1 + power.q*e2 + sum.p*c;
+        _state.y1 = static_cast<float>(fixed_point + y1);
+        _state.y2 = static_cast<float>(fixed_point + y2);
+        return _state.y1;
+    }
+
     float filter_weighted(float input) {
         const float output = filter(input);
         // weight of 1.0 gives just output, weight of 0.0 gives just input
         return (output - input)*_weight + input;
     }
 
+    void filter_block(const float* input, float* output, size_t count);
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
     void init_lowpass(float frequency_hz, float looptime_seconds, float q) {
         assert(q != 0.0F && "q cannot be zero");
         set_looptime(looptime_seconds);
@@ -235,9 +422,11 @@ public:
 
     float calculate_omega(float frequency) const { return frequency*_2_pi_looptime_seconds; }
 
+    template <typename TRIG = FilterTrig>
     void set_low_pass_frequencyWeighted(float frequency_hz, float weight);
     void set_low_pass_frequency(float frequency_hz) { set_low_pass_frequencyWeighted(frequency_hz, 1.0F); }
 
+    template <typename TRIG = FilterTrig>
     void set_notch_frequency_weighted(float frequency_hz, float weight); // assumes q already set
     void set_notch_frequency(float frequency_hz) {set_notch_frequency_weighted(frequency_hz, 1.0F); } // assumes q already set
     void set_notch_frequency_weighted(float sin_omega, float two_cos_omega, float weight);
@@ -257,6 +446,8 @@ public:
     float get_q() const { return (1.0F/_2q_reciprocal)/2.0F; }
 
     void set_looptime(float looptime_seconds) { _2_pi_looptime_seconds = 2.0F*PI_F*looptime_seconds; }
+    //! Sets the state, eg to continue from a state saved with `get_state()`.
+    void set_state(const state_t& state) { _state = state; }
 // for testing
     const state_t& get_state() const { return _state; }
 protected:
@@ -277,21 +468,18 @@ protected:
 
 /*!
 Note: weight must be in range [0, 1].
+`TRIG` is the trigonometry policy used to calculate the coefficients, see filter_trig.h.
 */
+template <typename TRIG>
 inline void BiquadFilter::set_low_pass_frequencyWeighted(float frequency_hz, float weight)
 {
     _weight = weight;
 
     const float omega = frequency_hz*_2_pi_looptime_seconds;
-#if defined(LIBRARY_FILTER_USE_SINCOS)
     float sin_omega {};
     float cos_omega {};
-    sincosf(omega, &sin_omega, &cos_omega);
+    TRIG::sincos(omega, sin_omega, cos_omega);
     const float alpha = sin_omega*_2q_reciprocal;
-#else
-    const float cos_omega = cosf(omega);
-    const float alpha = sinf(omega)*_2q_reciprocal;
-#endif
     const float a0_reciprocal = 1.0F/(1.0F + alpha);
 
     _b1 = (1.0F - cos_omega)*a0_reciprocal;
@@ -303,21 +491,18 @@ inline void BiquadFilter::set_low_pass_frequencyWeighted(float frequency_hz, flo
 
 /*!
 Note: weight must be in range [0, 1].
+`TRIG` is the trigonometry policy used to calculate the coefficients, see filter_trig.h.
 */
+template <typename TRIG>
 inline void BiquadFilter::set_notch_frequency_weighted(float frequency_hz, float weight)
 {
     _weight = weight;
 
     const float omega = frequency_hz*_2_pi_looptime_seconds;
-#if defined(LIBRARY_FILTER_USE_SINCOS)
     float sin_omega {};
     float cos_omega {};
-    sincosf(omega, &sin_omega, &cos_omega);
+    TRIG::sincos(omega, sin_omega, cos_omega);
     const float alpha = sin_omega*_2q_reciprocal;
-#else
-    const float cos_omega = cosf(omega);
-    const float alpha = sinf(omega)*_2q_reciprocal;
-#endif
     const float a0_reciprocal = 1.0F/(1.0F + alpha);
 
     _b0 = a0_reciprocal;
@@ -344,44 +529,344 @@ inline void BiquadFilter::set_notch_frequency_weighted(float sin_omega, float tw
     _a2 = (1.0F - alpha)*a0_reciprocal;
 }
 
+/*!
+Filters `count` samples from `input` into `output`, `input` and `output` may be the same buffer.
+
+Uses a modified transposed direct form II that carries three values from sample to sample, `s1`, `s2` and the previous output `y1`,
+all of which stay in registers for the whole block. The `-a1*y1` term is left out of `s1` and applied when the next output is calculated,
+so the recursive path from one output to the next is a single multiply and subtract.
+The direct form I state is converted on entry and restored on exit, so `filter()` and `filter_block()` may be freely interleaved.
+Output matches `filter()` to within float rounding.
+*/
+inline void BiquadFilter::filter_block(const float* input, float* output, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    // save the last two inputs, since they are overwritten when filtering in place
+    const float x1 = input[count - 1];
+    const float x2 = count > 1 ? input[count - 2] : _state.x1;
+    const float y2 = _state.y1;
+
+    const float b0 = _b0;
+    const float b1 = _b1;
+    const float b2 = _b2;
+    const float a1 = _a1;
+    const float a2 = _a2;
+    // s1 is held without its -y1*a1 term, which is applied when the next output is calculated,
+    // this leaves a single multiply and subtract on the recursive path from one output to the next
+    float y1 = _state.y1;
+    float s1 = _state.x1*b1 + _state.x2*b2 - _state.y2*a2;
+    float s2 = _state.x1*b2 - _state.y1*a2;
+    for (size_t ii = 0; ii < count; ++ii) {
+        const float x = input[ii];
+        const float y = x*b0 + s1 - y1*a1;
+        s1 = s2 + x*b1;
+        s2 = x*b2 - y*a2;
+        y1 = y;
+        output[ii] = y;
+    }
+
+    _state.x1 = x1;
+    _state.x2 = x2;
+    _state.y1 = output[count - 1];
+    _state.y2 = count > 1 ? output[count - 2] : y2;
+}
+
+
+/*!
+Biquad filter whose coefficients can be moved smoothly to a new set of target coefficients.
+
+Setting a target, eg using `set_target_notch_frequency()`, calculates the target coefficients once; the coefficients and the weight are then
+interpolated linearly from their current values to the target over `ramp_samples` samples, at the cost of six additions per sample.
+This avoids both the trigonometry of recalculating the coefficients every sample and the transients of jumping them every few samples.
+
+The set of stable biquads is convex in (a1, a2), so a linear interpolation between two stable filters is itself stable at every step.
+The direct form I state does not depend on the coefficients, so the coefficients can change on any sample.
+
+With a `ramp_samples` of zero, setting a target sets the coefficients immediately, as for `BiquadFilter`.
+Coefficients set directly, eg by `set_notch_frequency()`, are overwritten by any ramp in progress.
+Setting a target without a weight keeps the weight of any target in progress, rather than the partly interpolated weight.
+
+`filter()`, `filter_weighted()`, `filter_block()` and `advance()` hide, rather than override, the non-virtual functions of `BiquadFilter`,
+so calls through a `BiquadFilter&` or `BiquadFilter*` do not step the ramp. Only `filter_virtual()` ramps when called through the base class.
+*/
+class BiquadFilterRamped : public BiquadFilter {
+public:
+    using BiquadFilter::BiquadFilter;
+public:
+    void set_ramp_samples(uint32_t ramp_samples) { _ramp_samples = ramp_samples; }
+    uint32_t get_ramp_samples() const { return _ramp_samples; }
+    bool is_ramping() const { return _ramp_remaining > 0; }
+    //! The weight at the end of any ramp in progress, otherwise the current weight.
+    float get_target_weight() const { return is_ramping() ? _target_weight : _weight; }
+
+    void set_target_parameters(const biquad_coefficients_t& target, float weight);
+    void set_target_parameters(const biquad_coefficients_t& target) { set_target_parameters(target, get_target_weight()); }
+    template <typename TRIG = FilterTrig>
+    void set_target_low_pass_frequency(float frequency_hz) {
+        const float weight = get_target_weight();
+        BiquadFilter target(*this);
+        target.set_low_pass_frequencyWeighted<TRIG>(frequency_hz, weight);
+        set_target_parameters(target.get_parameters(), weight);
+    }
+    template <typename TRIG = FilterTrig>
+    void set_target_notch_frequency_weighted(float frequency_hz, float weight) {
+        BiquadFilter target(*this);
+        target.set_notch_frequency_weighted<TRIG>(frequency_hz, weight);
+        set_target_parameters(target.get_parameters(), weight);
+    }
+    void set_target_notch_frequency(float frequency_hz) { set_target_notch_frequency_weighted(frequency_hz, get_target_weight()); }
+
+    float filter(float input) { step_ramp(); return BiquadFilter::filter(input); }
+    virtual float filter_virtual(float input) override { return filter(input); }
+    float filter_weighted(float input) { step_ramp(); return BiquadFilter::filter_weighted(input); }
+    //! Samples during a ramp are filtered one at a time, the remainder uses `BiquadFilter::advance()`.
+    float advance(float input, size_t count) {
+        for (; count > 0 && is_ramping(); --count) {
+            filter(input);
+        }
+        return BiquadFilter::advance(input, count);
+    }
+
+    void filter_block(const float* input, float* output, size_t count);
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+private:
+    void step_ramp() {
+        if (_ramp_remaining == 0) {
+            return;
+        }
+        if (--_ramp_remaining == 0) {
+            // finish exactly on the target, without accumulated rounding error
+            set_parameters(_target.a1, _target.a2, _target.b0, _target.b1, _target.b2, _target_weight);
+            return;
+        }
+        _a1 += _delta.a1;
+        _a2 += _delta.a2;
+        _b0 += _delta.b0;
+        _b1 += _delta.b1;
+        _b2 += _delta.b2;
+        _weight += _weight_delta;
+    }
+protected:
+    biquad_coefficients_t _target {};
+    biquad_coefficients_t _delta {};
+    float _target_weight {1.0F};
+    float _weight_delta {0.0F};
+    uint32_t _ramp_samples {0};
+    uint32_t _ramp_remaining {0};
+};
+
+/*!
+Sets the target coefficients and weight, which are reached after `ramp_samples` calls to `filter()`.
+If a ramp is already in progress, the new ramp starts from the current, partly interpolated, coefficients.
+*/
+inline void BiquadFilterRamped::set_target_parameters(const biquad_coefficients_t& target, float weight)
+{
+    _target = target;
+    _target_weight = weight;
+    if (_ramp_samples == 0) {
+        _ramp_remaining = 0;
+        set_parameters(target.a1, target.a2, target.b0, target.b1, target.b2, weight);
+        return;
+    }
+    const float ramp_reciprocal = 1.0F/static_cast<float>(_ramp_samples);
+    _delta.a1 = (target.a1 - _a1)*ramp_reciprocal;
+    _delta.a2 = (target.a2 - _a2)*ramp_reciprocal;
+    _delta.b0 = (target.b0 - _b0)*ramp_reciprocal;
+    _delta.b1 = (target.b1 - _b1)*ramp_reciprocal;
+    _delta.b2 = (target.b2 - _b2)*ramp_reciprocal;
+    _weight_delta = (weight - _weight)*ramp_reciprocal;
+    _ramp_remaining = _ramp_samples;
+}
+
+/*!
+Filters `count` samples from `input` into `output`, `input` and `output` may be the same buffer.
+
+Samples during a ramp are filtered one at a time, using the direct form I, the remainder of the block uses `BiquadFilter::filter_block()`.
+*/
+inline void BiquadFilterRamped::filter_block(const float* input, float* output, size_t count)
+{
+    const size_t ramp_count = std::min(count, static_cast<size_t>(_ramp_remaining));
+    for (size_t ii = 0; ii < ramp_count; ++ii) {
+        output[ii] = filter(input[ii]);
+    }
+    BiquadFilter::filter_block(input + ramp_count, output + ramp_count, count - ramp_count);
+}
 
 /*!
 Simple moving average filter.
 See [Moving Average Filter - Theory and Software Implementation - Phil's Lab #21](https://www.youtube.com/watch?v=rttn46_Y3c8).
+
+The running sum is accumulated using the `SUM` policy, see filter_sum.h. With the default, `SumPlain<float>`, the sum drifts
+from the true sum of the window over a long run, use `SumNeumaier<float>` for a sum that does not drift.
+
+After `reset()` the output is the average of the samples so far, until the window is full.
+After `reset_to(value)` the window behaves as if it were full of `value`: the samples of the window are not written,
+instead each of the first `N` samples displaces a `value` from the running sum, so `reset_to` is O(1).
 */
-template <size_t N>
+template <size_t N, typename SUM = SumPlain<float>>
 class FilterMovingAverage : public FilterBase {
 public:
     FilterMovingAverage() {} // cppcheck-suppress uninitMemberVar
 public:
-    void reset() { _sum = {}; _count = 0; _index = 0;}
+    void reset() { _sum.reset(); _count = 0; _index = 0; _fill = 0.0F; _warm = false; }
+    void reset_to(float value) { _sum.reset(); _sum.add(value*static_cast<float>(N)); _count = 0; _index = 0; _fill = value; _warm = true; }
 
     float filter(float input);
     float filter(float input, float dt) { (void)dt; return filter(input); }
     virtual float filter_virtual(float input) override { return filter(input); }
 protected:
+    static constexpr float N_RECIPROCAL = 1.0F/static_cast<float>(N);
     size_t _count {0};
     size_t _index {0};
-    float _sum {0};
+    SUM _sum {};
+    float _fill {0.0F}; //!< value that the first N samples displace from the sum, set by `reset_to()`
+    bool _warm {false}; //!< true after `reset_to()`, when the average is over the whole window while it fills
     std::array<float, N> _samples;
 };
 
-template <size_t N>
-inline float FilterMovingAverage<N>::filter(float input)
+template <size_t N, typename SUM>
+inline float FilterMovingAverage<N, SUM>::filter(float input)
 {
-    _sum = _sum + input;
+    _sum.add(input);
     if (_count < N) {
         _samples[_index] = input;
         ++_index;
         ++_count;
-        return _sum*(1.0F/static_cast<float>(_count));
+        if (_warm) {
+            _sum.subtract(_fill);
+            return _sum.sum()*N_RECIPROCAL;
+        }
+        return _sum.sum()*(1.0F/static_cast<float>(_count));
     }
     if (_index == N) {
         _index = 0;
     }
-    _sum = _sum - _samples[_index];
+    _sum.subtract(_samples[_index]);
     _samples[_index] = input;
     ++_index;
-    static constexpr float N_RECIPROCAL = 1.0F/static_cast<float>(N);
-    return _sum*N_RECIPROCAL;
+    return _sum.sum()*N_RECIPROCAL;
+}
+
+/*!
+Moving averages over several window lengths of the same signal, eg `FilterMultiMovingAverage<4, 16, 64>`.
+
+A single history of the last `max(Ns...)` samples is shared by all the windows, and each window keeps its own running sum,
+so each sample costs one addition and one subtraction per window, and the memory used is that of the largest window alone,
+rather than that of separate `FilterMovingAverage` filters.
+The history is not rounded up to a power of two, instead the position of the sample leaving each window is found with a compare and select.
+If the largest window is a power of two the position is found by masking, which is slightly faster, so to opt in to that at the cost of
+memory, round the largest window up to a power of two.
+
+The running sums are accumulated using the `SUM` policy, as for `FilterMovingAverage`, eg
+`FilterMultiMovingAverageSum<SumNeumaier<float>, 4, 16, 64>` for sums that do not drift over a long run.
+`FilterMultiMovingAverage<Ns...>` uses `SumPlain<float>`.
+
+`filter()` returns the outputs of all the windows, in the order of `Ns`. `filter_virtual()` returns the output of the first window.
+While the history is filling, each output is the average of the samples so far, or after `reset_to(value)` the windows behave as if
+the history were full of `value`. As for `FilterMovingAverage` the history is not written by `reset()` or `reset_to()`, so both are O(1).
+*/
+template <typename SUM, size_t... Ns>
+class FilterMultiMovingAverageSum : public FilterBase {
+public:
+    static constexpr size_t WINDOW_COUNT = sizeof...(Ns);
+    static constexpr size_t MAX_N = std::max({Ns...});
+    static_assert(WINDOW_COUNT >= 1, "there must be at least one window");
+    static_assert(((Ns >= 1) && ...), "window lengths must be at least 1");
+    using outputs_t = std::array<float, WINDOW_COUNT>;
+public:
+    FilterMultiMovingAverageSum() = default;
+public:
+    void reset() { reset_sums(0.0F); _warm = false; }
+    void reset_to(float value) { reset_sums(value); _warm = true; }
+
+    outputs_t filter(float input);
+    outputs_t filter(float input, float dt) { (void)dt; return filter(input); }
+    virtual float filter_virtual(float input) override { return filter(input)[0]; }
+
+    //! The output of `window` for the last sample filtered.
+    float get_output(size_t window) const {
+        const size_t count = _warm ? WINDOWS[window] : std::min(_count, WINDOWS[window]);
+        return count == 0 ? 0.0F : _sums[window].sum()/static_cast<float>(count);
+    }
+    static constexpr size_t window_length(size_t window) { return WINDOWS[window]; }
+protected:
+    void reset_sums(float value) {
+        for (size_t ii = 0; ii < WINDOW_COUNT; ++ii) {
+            _sums[ii].reset();
+            _sums[ii].add(value*static_cast<float>(WINDOWS[ii]));
+        }
+        _fill = value;
+        _count = 0;
+        _index = 0;
+    }
+    /*!
+    Wraps `position`, which may have wrapped below zero, into the history.
+    If `MAX_N` is a power of two this is a mask, otherwise `MAX_N` is added by masking rather than by a branch, which
+    would be mispredicted each time the position wraps.
+    */
+    static size_t history_position(size_t position) {
+        if constexpr (std::has_single_bit(MAX_N)) {
+            return position & (MAX_N - 1);
+        } else {
+            return position + (MAX_N & (0U - static_cast<size_t>(position >= MAX_N)));
+        }
+    }
+    /*!
+    Updates window `I`. The sample that drops out of the window was pushed `WINDOWS[I]` samples ago, or if fewer samples than that
+    have been filtered since the last reset it is `_fill`, which is zero after `reset()`. The history is always read, so the choice is a select.
+    */
+    template <size_t I>
+    float update_window(float input) {
+        constexpr size_t N = WINDOWS[I];
+        const float sample = _samples[history_position(_index - N)];
+        _sums[I].add(input);
+        _sums[I].subtract(_count >= N ? sample : _fill);
+        return _sums[I].sum()*RECIPROCALS[I];
+    }
+    //! The windows are updated by a fold expression, so each window has a compile-time length and the outputs are returned in registers.
+    template <size_t... Is>
+    outputs_t update_windows(float input, std::index_sequence<Is...>) { return outputs_t {{ update_window<Is>(input)... }}; }
+protected:
+    static constexpr std::array<size_t, WINDOW_COUNT> WINDOWS {{ Ns... }};
+    static constexpr std::array<float, WINDOW_COUNT> RECIPROCALS {{ (1.0F/static_cast<float>(Ns))... }};
+    size_t _count {0}; //!< number of samples filtered since the last reset, up to `MAX_N`
+    size_t _index {0}; //!< position of the next sample in the history
+    std::array<SUM, WINDOW_COUNT> _sums {};
+    float _fill {0.0F}; //!< value that the first samples of each window displace from its sum, set by `reset_to()`
+    bool _warm {false}; //!< true after `reset_to()`, when the average is over the whole window while it fills
+    std::array<float, MAX_N> _samples {};
+};
+
+template <size_t... Ns>
+using FilterMultiMovingAverage = FilterMultiMovingAverageSum<SumPlain<float>, Ns...>;
+
+/*!
+The sums are updated the same way for every sample, with `_fill` standing in for the samples from before the reset.
+Only the outputs of windows that have not yet filled after `reset()` need a different divisor.
+*/
+template <typename SUM, size_t... Ns>
+typename FilterMultiMovingAverageSum<SUM, Ns...>::outputs_t FilterMultiMovingAverageSum<SUM, Ns...>::filter(float input)
+{
+    outputs_t outputs = update_windows(input, std::make_index_sequence<WINDOW_COUNT>{});
+    _samples[_index] = input;
+    if constexpr (std::has_single_bit(MAX_N)) {
+        _index = (_index + 1) & (MAX_N - 1);
+    } else {
+        _index = (_index + 1 == MAX_N) ? 0 : _index + 1;
+    }
+    if (_count < MAX_N) {
+        ++_count;
+        if (!_warm) {
+            const float count_reciprocal = 1.0F/static_cast<float>(_count);
+            for (size_t ii = 0; ii < WINDOW_COUNT; ++ii) {
+                if (_count < WINDOWS[ii]) {
+                    outputs[ii] = _sums[ii].sum()*count_reciprocal;
+                }
+            }
+        }
+    }
+    return outputs;
 }
+
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "filters.h"
+
+#include <limits>
+#include <type_traits>
+
+
+/*!
+Fixed point filters, for targets without a floating point unit.
+
+Samples are Q15 (`int16_t`) or Q31 (`int32_t`), that is signed fractions in the range [-1, 1).
+Coefficients are calculated in float using the same design functions as the floating point filters, and are converted
+to fixed point at configuration time, so only the configuration functions use floating point.
+
+All multiply-accumulates are done in a 64 bit accumulator, which on ARM Cortex-M3 and above compiles to `SMLAL`.
+Results are rounded and saturated when they are narrowed to the sample type.
+*/
+template <typename Sample>
+struct FixedPoint {
+    static_assert(std::is_same_v<Sample, int16_t> || std::is_same_v<Sample, int32_t>, "Sample must be int16_t (Q15) or int32_t (Q31)");
+    static constexpr int FRACTIONAL_BITS = std::numeric_limits<Sample>::digits;
+    static constexpr float ONE = static_cast<float>(int64_t{1} << FRACTIONAL_BITS);
+    static constexpr int64_t MAX = std::numeric_limits<Sample>::max();
+    static constexpr int64_t MIN = std::numeric_limits<Sample>::min();
+
+    static Sample saturate(int64_t value) { return static_cast<Sample>(std::clamp(value, MIN, MAX)); }
+    //! Rounding arithmetic right shift
+    static int64_t shift_right(int64_t value, int shift) { return (value + (int64_t{1} << (shift - 1))) >> shift; }
+    //! Converts a float in the range [-1, 1) to fixed point, values outside the range are saturated.
+    static Sample from_float(float value) {
+        const float scaled = std::clamp(value, -1.0F, 1.0F)*ONE;
+        return saturate(static_cast<int64_t>(scaled + (scaled >= 0.0F ? 0.5F : -0.5F)));
+    }
+    static float to_float(Sample value) { return static_cast<float>(value)*(1.0F/ONE); }
+};
+
+
+/*!
+Fixed point biquad filter, using the direct form I, which has a single accumulator and no internal overflow.
+
+Coefficients are held in `int32_t` and are saturated to the range [-2, 2), which covers all stable lowpass and notch filters.
+Each of the five products is at most 2 times full scale, so the accumulator must hold 10 times full scale without overflow.
+Q15 filters hold the coefficients as Q2.29, so the largest sum is under 2^48.
+Q31 filters hold the coefficients as Q3.28, with a third guard bit, so the largest sum is 5*2^60 which is within the 64 bit accumulator
+for any input and any coefficients. With Q2.29 coefficients the sum would overflow whenever the sum of the absolute values of the coefficients reached 8.
+
+The output rounding error is recirculated by the poles, which amplify it as the cutoff frequency falls and the poles move towards the unit circle.
+To counter this the rounding error is saved and added into the next output (first order error feedback), which places a zero of the error transfer function at DC.
+
+Error bound, relative to `BiquadFilter` given the same quantized input, measured for lowpass and notch filters with cutoffs from 1% to 25% of the sample rate:
+Q15: within 5 LSB at 1% of the sample rate and within 3 LSB from 5% upwards.
+Q31: within 2e-5, which is dominated by the rounding error of the float reference itself.
+*/
+template <typename Sample>
+class BiquadFilterQ {
+public:
+    using fixed_point_t = FixedPoint<Sample>;
+    static constexpr int COEFFICIENT_FRACTIONAL_BITS = std::is_same_v<Sample, int16_t> ? 29 : 28;
+    struct state_t {
+        Sample x1;
+        Sample x2;
+        Sample y1;
+        Sample y2;
+        int64_t error;
+    };
+public:
+    BiquadFilterQ() { set_to_passthrough(); }
+    explicit BiquadFilterQ(const biquad_coefficients_t& coefficients) { set_parameters(coefficients); }
+public:
+    void set_parameters(const biquad_coefficients_t& coefficients) {
+        _a1 = coefficient_from_float(coefficients.a1);
+        _a2 = coefficient_from_float(coefficients.a2);
+        _b0 = coefficient_from_float(coefficients.b0);
+        _b1 = coefficient_from_float(coefficients.b1);
+        _b2 = coefficient_from_float(coefficients.b2);
+    }
+    void set_parameters(float a1, float a2, float b0, float b1, float b2) { set_parameters(biquad_coefficients_t { a1, a2, b0, b1, b2 }); }
+    biquad_coefficients_t get_parameters() const {
+        return biquad_coefficients_t { coefficient_to_float(_a1), coefficient_to_float(_a2), coefficient_to_float(_b0), coefficient_to_float(_b1), coefficient_to_float(_b2) };
+    }
+
+    void reset() { _state = state_t {}; }
+    void set_to_passthrough() { set_parameters(0.0F, 0.0F, 1.0F, 0.0F, 0.0F); reset(); }
+
+    Sample filter(Sample input) {
+        const int64_t acc = int64_t{_b0}*input + int64_t{_b1}*_state.x1 + int64_t{_b2}*_state.x2 - int64_t{_a1}*_state.y1 - int64_t{_a2}*_state.y2
+            + _state.error;
+        const int64_t rounded = fixed_point_t::shift_right(acc, COEFFICIENT_FRACTIONAL_BITS);
+        const Sample output = fixed_point_t::saturate(rounded);
+        // error feedback, not done after saturation, since the error is then unbounded
+        _state.error = (rounded == output) ? acc - (rounded << COEFFICIENT_FRACTIONAL_BITS) : 0;
+        _state.x2 = _state.x1;
+        _state.x1 = input;
+        _state.y2 = _state.y1;
+        _state.y1 = output;
+        return output;
+    }
+    void filter_block(const Sample* input, Sample* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(Sample* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void init_lowpass(float frequency_hz, float looptime_seconds, float q) {
+        BiquadFilter filter;
+        filter.init_lowpass(frequency_hz, looptime_seconds, q);
+        set_parameters(filter.get_parameters());
+        reset();
+    }
+    void init_notch(float frequency_hz, float looptime_seconds, float q) {
+        BiquadFilter filter;
+        filter.init_notch(frequency_hz, looptime_seconds, q);
+        set_parameters(filter.get_parameters());
+        reset();
+    }
+// for testing
+    const state_t& get_state() const { return _state; }
+private:
+    static constexpr float COEFFICIENT_ONE = static_cast<float>(int32_t{1} << COEFFICIENT_FRACTIONAL_BITS);
+    static int32_t coefficient_from_float(float value) {
+        const float scaled = std::clamp(value, -2.0F, 2.0F)*COEFFICIENT_ONE;
+        const auto rounded = static_cast<int64_t>(scaled + (scaled >= 0.0F ? 0.5F : -0.5F));
+        return static_cast<int32_t>(std::clamp(rounded, int64_t{-2}*(int64_t{1} << COEFFICIENT_FRACTIONAL_BITS), int64_t{2}*(int64_t{1} << COEFFICIENT_FRACTIONAL_BITS) - 1));
+    }
+    static float coefficient_to_float(int32_t value) { return static_cast<float>(value)*(1.0F/COEFFICIENT_ONE); }
+protected:
+    int32_t _a1 {};
+    int32_t _a2 {};
+    int32_t _b0 {};
+    int32_t _b1 {};
+    int32_t _b2 {};
+    state_t _state {};
+};
+
+using BiquadFilterQ15 = BiquadFilterQ<int16_t>;
+using BiquadFilterQ31 = BiquadFilterQ<int32_t>;
+
+
+/*!
+Fixed point power transfer filter of order 1, 2 or 3, equivalent to `PowerTransferFilter1`, `PowerTransferFilter2` and `PowerTransferFilter3`.
+
+The gain `k` is held as Q30 and the state as Q31 in `int64_t`, so Q15 filters have 16 extra bits of state precision.
+Without them a Q15 filter with a low cutoff would stall up to `1/k` LSB short of a step input.
+
+Error bound, relative to the float filter given the same quantized input, for gains from 0.001 to 1: Q15: within 1 LSB, Q31: within 1e-6.
+*/
+template <size_t Order, typename Sample>
+class PowerTransferFilterQ {
+public:
+    static_assert(Order >= 1 && Order <= 3, "Order must be 1, 2 or 3");
+    using fixed_point_t = FixedPoint<Sample>;
+    static constexpr int GAIN_FRACTIONAL_BITS = 30;
+    static constexpr int STATE_FRACTIONAL_BITS = 31;
+    static constexpr int STATE_SHIFT = STATE_FRACTIONAL_BITS - fixed_point_t::FRACTIONAL_BITS;
+public:
+    explicit PowerTransferFilterQ(float k) { init(k); }
+    PowerTransferFilterQ() : PowerTransferFilterQ(1.0F) {}
+    PowerTransferFilterQ(float cutoff_frequency_hz, float dt) : PowerTransferFilterQ(gain_from_frequency(cutoff_frequency_hz, dt)) {}
+public:
+    void init(float k) { _k = gain_to_fixed(k); reset(); }
+    void reset() { _state.fill(0); }
+    void set_to_passthrough() { init(1.0F); }
+
+    Sample filter(Sample input) {
+        int64_t value = int64_t{input} << STATE_SHIFT;
+        for (size_t ii = Order; ii > 0; --ii) {
+            int64_t& state = _state[ii - 1];
+            state += fixed_point_t::shift_right((value - state)*_k, GAIN_FRACTIONAL_BITS);
+            value = state;
+        }
+        if constexpr (STATE_SHIFT > 0) {
+            return fixed_point_t::saturate(fixed_point_t::shift_right(value, STATE_SHIFT));
+        }
+        return fixed_point_t::saturate(value);
+    }
+    void filter_block(const Sample* input, Sample* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(Sample* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { _k = gain_to_fixed(gain_from_frequency(cutoff_frequency_hz, dt)); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
+    static float gain_from_delay(float delay, float dt) {
+        if constexpr (Order == 1) {
+            return PowerTransferFilter1::gain_from_delay(delay, dt);
+        } else if constexpr (Order == 2) {
+            return PowerTransferFilter2::gain_from_delay(delay, dt);
+        } else {
+            return PowerTransferFilter3::gain_from_delay(delay, dt);
+        }
+    }
+    static float gain_from_frequency(float cutoff_frequency_hz, float dt) {
+        if constexpr (Order == 1) {
+            return PowerTransferFilter1::gain_from_frequency(cutoff_frequency_hz, dt);
+        } else if constexpr (Order == 2) {
+            return PowerTransferFilter2::gain_from_frequency(cutoff_frequency_hz, dt);
+        } else {
+            return PowerTransferFilter3::gain_from_frequency(cutoff_frequency_hz, dt);
+        }
+    }
+// for testing
+    int32_t get_gain() const { return _k; }
+    const std::array<int64_t, Order>& get_state() const { return _state; }
+private:
+    static int32_t gain_to_fixed(float k) {
+        return static_cast<int32_t>(std::clamp(k, 0.0F, 1.0F)*static_cast<float>(int32_t{1} << GAIN_FRACTIONAL_BITS) + 0.5F);
+    }
+protected:
+    int32_t _k {};
+    std::array<int64_t, Order> _state {};
+};
+
+using PowerTransferFilter1Q15 = PowerTransferFilterQ<1, int16_t>;
+using PowerTransferFilter2Q15 = PowerTransferFilterQ<2, int16_t>;
+using PowerTransferFilter3Q15 = PowerTransferFilterQ<3, int16_t>;
+using PowerTransferFilter1Q31 = PowerTransferFilterQ<1, int32_t>;
+using PowerTransferFilter2Q31 = PowerTransferFilterQ<2, int32_t>;
+using PowerTransferFilter3Q31 = PowerTransferFilterQ<3, int32_t>;
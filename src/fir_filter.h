@@ -0,0 +1,164 @@
+#pragma once
+
+#include "filter_simd.h"
+#include "filter_templates.h"
+#include "filters.h"
+
+
+/*!
+Finite impulse response filter with `Taps` coefficients.
+
+The sample history is held in a doubled linear buffer: each sample is written twice, `Taps` apart,
+so that the most recent `Taps` samples are always contiguous, newest first.
+This means the convolution is a single contiguous dot product, which is vectorized, rather than a loop of modulo-indexed reads.
+
+`init_lowpass` designs a linear-phase windowed-sinc lowpass filter, which has a group delay of `(Taps - 1)/2` samples.
+*/
+template <size_t Taps>
+class FIRFilter : public FilterBase {
+public:
+    FIRFilter() { set_to_passthrough(); }
+    explicit FIRFilter(const std::array<float, Taps>& coefficients) : _coefficients(coefficients) {}
+public:
+    void set_coefficients(const std::array<float, Taps>& coefficients) { _coefficients = coefficients; }
+    const std::array<float, Taps>& get_coefficients() const { return _coefficients; }
+
+    void reset() { _history.fill(0.0F); _index = 0; }
+    void set_to_passthrough() { _coefficients.fill(0.0F); _coefficients[0] = 1.0F; reset(); }
+
+    float filter(float input) {
+        _index = (_index == 0) ? Taps - 1 : _index - 1;
+        _history[_index] = input;
+        _history[_index + Taps] = input;
+        return FilterSimd::dot_product<Taps>(&_coefficients[0], &_history[_index]);
+    }
+    float filter(float input, float dt) { (void)dt; return filter(input); }
+    virtual float filter_virtual(float input) override { return filter(input); }
+
+    void filter_block(const float* input, float* output, size_t count);
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void init_lowpass(float cutoff_frequency_hz, float looptime_seconds) {
+        set_windowed_sinc_lowpass(_coefficients, cutoff_frequency_hz, looptime_seconds);
+        reset();
+    }
+    static constexpr float group_delay() { return static_cast<float>(Taps - 1)*0.5F; }
+
+    static void set_windowed_sinc_lowpass(std::array<float, Taps>& coefficients, float cutoff_frequency_hz, float looptime_seconds);
+    static constexpr size_t DIRECT_BLOCK_MAX_TAPS = 16; //!< `filter_block` convolves directly from the input for up to this many taps
+protected:
+    std::array<float, Taps> _coefficients {};
+    std::array<float, 2*Taps> _history {};
+    size_t _index {0};
+protected:
+    static constexpr float PI_F = 3.14159265358979323846F;
+};
+
+/*!
+For small `Taps` the vectorized dot product gains little, and its loads overlap the history just written, which stalls store forwarding,
+so the outputs whose whole window lies within the block are convolved directly from the input with a scalar loop.
+The outputs are calculated last to first, so the input is still intact when it is filtered in place, and the history is set from the end of the block.
+*/
+template <size_t Taps>
+void FIRFilter<Taps>::filter_block(const float* input, float* output, size_t count)
+{
+    if constexpr (Taps <= DIRECT_BLOCK_MAX_TAPS) {
+        if (count >= Taps) {
+            std::array<float, Taps> newest {};
+            for (size_t k = 0; k < Taps; ++k) {
+                newest[k] = input[count - 1 - k];
+            }
+            for (size_t ii = count; ii-- > Taps - 1;) {
+                float sum = 0.0F;
+                for (size_t k = 0; k < Taps; ++k) {
+                    sum += _coefficients[k]*input[ii - k];
+                }
+                output[ii] = sum;
+            }
+            // the first outputs also need the history from before the block
+            for (size_t ii = 0; ii < Taps - 1; ++ii) {
+                output[ii] = filter(input[ii]);
+            }
+            _index = 0;
+            for (size_t k = 0; k < Taps; ++k) {
+                _history[k] = newest[k];
+                _history[k + Taps] = newest[k];
+            }
+            return;
+        }
+    }
+    for (size_t ii = 0; ii < count; ++ii) {
+        output[ii] = filter(input[ii]);
+    }
+}
+
+/*!
+Calculates the coefficients of a Hamming windowed-sinc lowpass filter, normalized to unity DC gain.
+*/
+template <size_t Taps>
+void FIRFilter<Taps>::set_windowed_sinc_lowpass(std::array<float, Taps>& coefficients, float cutoff_frequency_hz, float looptime_seconds)
+{
+    const float omega = 2.0F*PI_F*cutoff_frequency_hz*looptime_seconds;
+    const float middle = group_delay();
+    float sum = 0.0F;
+    for (size_t ii = 0; ii < Taps; ++ii) {
+        const float n = static_cast<float>(ii) - middle;
+        const float sinc = (n == 0.0F) ? omega/PI_F : sinf(omega*n)/(PI_F*n);
+        const float window = Taps > 1 ? 0.54F - 0.46F*cosf(2.0F*PI_F*static_cast<float>(ii)/static_cast<float>(Taps - 1)) : 1.0F;
+        coefficients[ii] = sinc*window;
+        sum += coefficients[ii];
+    }
+    for (float& coefficient : coefficients) {
+        coefficient /= sum;
+    }
+}
+
+
+/*!
+Templated finite impulse response filter, for example for filtering `xyz_t` values with scalar coefficients.
+
+Uses the same doubled linear history buffer as `FIRFilter`.
+*/
+template <typename T, size_t Taps>
+class FIRFilterT : public FilterBaseT<T> {
+public:
+    FIRFilterT() { set_to_passthrough(); }
+    explicit FIRFilterT(const std::array<float, Taps>& coefficients) : _coefficients(coefficients) {}
+public:
+    void set_coefficients(const std::array<float, Taps>& coefficients) { _coefficients = coefficients; }
+    const std::array<float, Taps>& get_coefficients() const { return _coefficients; }
+
+    void reset() { _history.fill(T{}); _index = 0; }
+    void set_to_passthrough() { _coefficients.fill(0.0F); _coefficients[0] = 1.0F; reset(); }
+
+    T filter(const T& input) {
+        _index = (_index == 0) ? Taps - 1 : _index - 1;
+        _history[_index] = input;
+        _history[_index + Taps] = input;
+        const T* history = &_history[_index];
+        T sum = history[0]*_coefficients[0];
+        for (size_t ii = 1; ii < Taps; ++ii) {
+            sum += history[ii]*_coefficients[ii];
+        }
+        return sum;
+    }
+    T filter(const T& input, float dt) { (void)dt; return filter(input); }
+    virtual T filter_virtual(const T& input) override { return filter(input); }
+
+    void filter_block(const T* input, T* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(T* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void init_lowpass(float cutoff_frequency_hz, float looptime_seconds) {
+        FIRFilter<Taps>::set_windowed_sinc_lowpass(_coefficients, cutoff_frequency_hz, looptime_seconds);
+        reset();
+    }
+    static constexpr float group_delay() { return FIRFilter<Taps>::group_delay(); }
+protected:
+    std::array<float, Taps> _coefficients {};
+    std::array<T, 2*Taps> _history {};
+    size_t _index {0};
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "fir_filter.h"
+#include "real_fft.h"
+
+#include <algorithm>
+#include <bit>
+
+
+/*!
+Finite impulse response filter for long kernels, using FFT overlap-save convolution.
+
+Has the same `filter_block` interface as `FIRFilter` and gives the same output, to within float rounding, so callers can choose
+the implementation by tap count: direct convolution costs O(Taps) per sample, overlap-save costs O(log(FFTSize)) per sample.
+As a rough guide `FIRFilterFFT` is faster than `FIRFilter` above 64 taps, and about ten times faster at 1024 taps.
+
+Input is processed in chunks of up to `FFTSize - Taps + 1` samples. Each chunk is transformed together with the preceding `Taps - 1` samples,
+multiplied by the kernel spectrum and transformed back; the first `Taps - 1` outputs are contaminated by circular wrap-around and discarded.
+A chunk is processed as soon as its input is available, so there is no latency beyond the group delay of the kernel itself,
+but calling `filter_block` with small counts is inefficient, since each call costs at least one forward and one inverse transform.
+
+`FFTSize` defaults to the smallest power of two that is at least four times `Taps`, which gives chunks of about three quarters of the transform size.
+
+This is intended for offline block processing: the object holds several `FFTSize` arrays, so should be allocated statically rather than on the stack.
+*/
+template <size_t Taps, size_t FFTSize = std::bit_ceil(4*Taps)>
+class FIRFilterFFT {
+public:
+    static_assert(Taps >= 2, "use FIRFilter for a single tap");
+    static_assert(FFTSize > Taps, "FFTSize must be greater than Taps");
+    static constexpr size_t CHUNK_SIZE = FFTSize - Taps + 1;
+public:
+    FIRFilterFFT() { set_to_passthrough(); }
+    explicit FIRFilterFFT(const std::array<float, Taps>& coefficients) { set_coefficients(coefficients); }
+public:
+    void set_coefficients(const std::array<float, Taps>& coefficients);
+    const std::array<float, Taps>& get_coefficients() const { return _coefficients; }
+
+    void reset() { _history.fill(0.0F); }
+    void set_to_passthrough() { std::array<float, Taps> coefficients {}; coefficients[0] = 1.0F; set_coefficients(coefficients); reset(); }
+
+    void filter_block(const float* input, float* output, size_t count);
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    void init_lowpass(float cutoff_frequency_hz, float looptime_seconds) {
+        std::array<float, Taps> coefficients {};
+        FIRFilter<Taps>::set_windowed_sinc_lowpass(coefficients, cutoff_frequency_hz, looptime_seconds);
+        set_coefficients(coefficients);
+        reset();
+    }
+    static constexpr float group_delay() { return FIRFilter<Taps>::group_delay(); }
+protected:
+    RealFFT<FFTSize> _fft;
+    std::array<float, Taps> _coefficients {};
+    std::array<float, FFTSize + 2> _kernel_spectrum {}; //!< spectrum of the coefficients, scaled by 1/FFTSize to normalize the inverse transform
+    std::array<float, FFTSize + 2> _spectrum {};
+    std::array<float, FFTSize> _frame {};
+    std::array<float, Taps - 1> _history {}; //!< the most recent Taps - 1 input samples, oldest first
+};
+
+template <size_t Taps, size_t FFTSize>
+void FIRFilterFFT<Taps, FFTSize>::set_coefficients(const std::array<float, Taps>& coefficients)
+{
+    _coefficients = coefficients;
+    std::copy(coefficients.begin(), coefficients.end(), _frame.begin());
+    std::fill(_frame.begin() + Taps, _frame.end(), 0.0F);
+    _fft.forward(_frame, _kernel_spectrum);
+    constexpr float SCALE = 1.0F/static_cast<float>(FFTSize);
+    for (float& value : _kernel_spectrum) {
+        value *= SCALE;
+    }
+}
+
+/*!
+Filters `count` samples from `input` into `output`, `input` and `output` may be the same buffer.
+*/
+template <size_t Taps, size_t FFTSize>
+void FIRFilterFFT<Taps, FFTSize>::filter_block(const float* input, float* output, size_t count)
+{
+    constexpr size_t HISTORY_SIZE = Taps - 1;
+    while (count > 0) {
+        const size_t chunk = std::min(count, CHUNK_SIZE);
+        // frame is [history | chunk | zeros]
+        std::copy(_history.begin(), _history.end(), _frame.begin());
+        std::copy(input, input + chunk, _frame.begin() + HISTORY_SIZE);
+        std::fill(_frame.begin() + HISTORY_SIZE + chunk, _frame.end(), 0.0F);
+        // the new history is the last Taps - 1 samples of [history | chunk]
+        std::copy(_frame.begin() + chunk, _frame.begin() + chunk + HISTORY_SIZE, _history.begin());
+
+        _fft.forward(_frame, _spectrum);
+        for (size_t ii = 0; ii < FFTSize + 2; ii += 2) {
+            const float re = _spectrum[ii]*_kernel_spectrum[ii] - _spectrum[ii + 1]*_kernel_spectrum[ii + 1];
+            const float im = _spectrum[ii]*_kernel_spectrum[ii + 1] + _spectrum[ii + 1]*_kernel_spectrum[ii];
+            _spectrum[ii] = re;
+            _spectrum[ii + 1] = im;
+        }
+        _fft.inverse(_spectrum, _frame);
+
+        std::copy(_frame.begin() + HISTORY_SIZE, _frame.begin() + HISTORY_SIZE + chunk, output);
+        input += chunk;
+        output += chunk;
+        count -= chunk;
+    }
+}
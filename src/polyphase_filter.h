@@ -0,0 +1,170 @@
+#pragma once
+
+#include "circular_buffer.h"
+#include "fir_filter.h"
+
+
+/*!
+Decimating FIR filter: lowpass filters the input and keeps one output in every `Ratio`.
+
+Only the outputs that are kept are calculated, so the cost is `Taps/Ratio` multiply-adds per input sample, rather than `Taps`.
+This is the polyphase decimator: each output is the sum, over the `Ratio` phases, of the phase subfilter applied to its phase of the input.
+The input history is held in the same doubled linear buffer as `FIRFilter`, so that each output is a single contiguous dot product.
+
+The latency, the group delay of the linear-phase lowpass filter, is `(Taps - 1)/2` input samples.
+*/
+template <size_t Taps, size_t Ratio>
+class FIRDecimator {
+public:
+    static_assert(Ratio >= 1, "Ratio must be at least 1");
+public:
+    FIRDecimator() { set_to_passthrough(); }
+    explicit FIRDecimator(const std::array<float, Taps>& coefficients) : _coefficients(coefficients) {}
+    static constexpr size_t ratio() { return Ratio; }
+public:
+    void set_coefficients(const std::array<float, Taps>& coefficients) { _coefficients = coefficients; }
+    const std::array<float, Taps>& get_coefficients() const { return _coefficients; }
+    //! Sets a windowed-sinc lowpass filter, `looptime_seconds` is the input sample interval.
+    void init_lowpass(float cutoff_frequency_hz, float looptime_seconds) {
+        FIRFilter<Taps>::set_windowed_sinc_lowpass(_coefficients, cutoff_frequency_hz, looptime_seconds);
+        reset();
+    }
+
+    void reset() { _history.fill(0.0F); _index = 0; _phase = 0; }
+    void set_to_passthrough() { _coefficients.fill(0.0F); _coefficients[0] = 1.0F; reset(); }
+
+    //! Latency in input samples.
+    static constexpr float latency() { return FIRFilter<Taps>::group_delay(); }
+    //! Latency in output samples.
+    static constexpr float latency_output_samples() { return latency()/static_cast<float>(Ratio); }
+
+    //! Adds an input sample, returns true and sets `output` if this sample completes an output.
+    bool filter(float input, float& output) {
+        push(input);
+        if (++_phase < Ratio) {
+            return false;
+        }
+        _phase = 0;
+        output = FilterSimd::dot_product<Taps>(&_coefficients[0], &_history[_index]);
+        return true;
+    }
+    /*!
+    Filters `count` input samples, writing up to `count/Ratio + 1` samples to `output`, and returns the number of output samples written.
+    Partial phases are carried over to the next call, so the input can be split into blocks of any size.
+    */
+    size_t filter_block(const float* input, float* output, size_t count) {
+        size_t output_count = 0;
+        for (size_t ii = 0; ii < count; ++ii) {
+            output_count += filter(input[ii], output[output_count]) ? 1 : 0;
+        }
+        return output_count;
+    }
+    //! Filters all the samples in `input`, which is emptied, and returns the number of output samples written.
+    template <size_t C>
+    size_t filter_block(CircularBuffer<float, C>& input, float* output) {
+        size_t output_count = 0;
+        float value {};
+        while (input.pop_front(value)) {
+            output_count += filter(value, output[output_count]) ? 1 : 0;
+        }
+        return output_count;
+    }
+private:
+    void push(float input) {
+        _index = (_index == 0) ? Taps - 1 : _index - 1;
+        _history[_index] = input;
+        _history[_index + Taps] = input;
+    }
+protected:
+    std::array<float, Taps> _coefficients {};
+    std::array<float, 2*Taps> _history {};
+    size_t _index {0};
+    size_t _phase {0};
+};
+
+
+/*!
+Interpolating FIR filter: produces `Ratio` output samples for each input sample, lowpass filtering to remove the images.
+
+Equivalent to inserting `Ratio - 1` zeros after each input sample and filtering at the output rate, but the zeros are never multiplied:
+the coefficients are split into `Ratio` phases of `ceil(Taps/Ratio)` coefficients, and output phase `p` is phase `p` of the filter
+applied to the input history, so the cost is `Taps` multiply-adds per input sample, rather than `Taps*Ratio`.
+
+The coefficients are scaled by `Ratio` to compensate for the zero insertion, so a lowpass filter with unity DC gain gives an interpolator with unity DC gain.
+
+The latency, the group delay of the linear-phase lowpass filter, is `(Taps - 1)/2` output samples.
+*/
+template <size_t Taps, size_t Ratio>
+class FIRInterpolator {
+public:
+    static_assert(Ratio >= 1, "Ratio must be at least 1");
+    static constexpr size_t PHASE_TAPS = (Taps + Ratio - 1)/Ratio;
+public:
+    FIRInterpolator() { set_to_passthrough(); }
+    explicit FIRInterpolator(const std::array<float, Taps>& coefficients) { set_coefficients(coefficients); }
+    static constexpr size_t ratio() { return Ratio; }
+public:
+    void set_coefficients(const std::array<float, Taps>& coefficients);
+    //! Sets a windowed-sinc lowpass filter, `looptime_seconds` is the output sample interval.
+    void init_lowpass(float cutoff_frequency_hz, float looptime_seconds) {
+        std::array<float, Taps> coefficients {};
+        FIRFilter<Taps>::set_windowed_sinc_lowpass(coefficients, cutoff_frequency_hz, looptime_seconds);
+        set_coefficients(coefficients);
+        reset();
+    }
+
+    void reset() { _history.fill(0.0F); _index = 0; }
+    //! Sets the filter to a sample and hold.
+    void set_to_passthrough() {
+        for (auto& coefficients : _phase_coefficients) {
+            coefficients.fill(0.0F);
+            coefficients[0] = 1.0F;
+        }
+        reset();
+    }
+
+    //! Latency in output samples.
+    static constexpr float latency() { return FIRFilter<Taps>::group_delay(); }
+
+    //! Filters `input`, writing `Ratio` samples to `output`.
+    void filter(float input, float* output) {
+        _index = (_index == 0) ? PHASE_TAPS - 1 : _index - 1;
+        _history[_index] = input;
+        _history[_index + PHASE_TAPS] = input;
+        for (size_t phase = 0; phase < Ratio; ++phase) {
+            output[phase] = FilterSimd::dot_product<PHASE_TAPS>(&_phase_coefficients[phase][0], &_history[_index]);
+        }
+    }
+    //! Filters `count` input samples, writing `count*Ratio` samples to `output`.
+    void filter_block(const float* input, float* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            filter(input[ii], &output[ii*Ratio]);
+        }
+    }
+    //! Filters all the samples in `input`, which is emptied, and returns the number of output samples written.
+    template <size_t C>
+    size_t filter_block(CircularBuffer<float, C>& input, float* output) {
+        size_t output_count = 0;
+        float value {};
+        while (input.pop_front(value)) {
+            filter(value, &output[output_count]);
+            output_count += Ratio;
+        }
+        return output_count;
+    }
+protected:
+    std::array<std::array<float, PHASE_TAPS>, Ratio> _phase_coefficients {}; //!< _phase_coefficients[p][k] = Ratio*coefficients[p + k*Ratio]
+    std::array<float, 2*PHASE_TAPS> _history {};
+    size_t _index {0};
+};
+
+template <size_t Taps, size_t Ratio>
+void FIRInterpolator<Taps, Ratio>::set_coefficients(const std::array<float, Taps>& coefficients)
+{
+    for (size_t phase = 0; phase < Ratio; ++phase) {
+        for (size_t k = 0; k < PHASE_TAPS; ++k) {
+            const size_t index = phase + k*Ratio;
+            _phase_coefficients[phase][k] = index < Taps ? coefficients[index]*static_cast<float>(Ratio) : 0.0F;
+        }
+    }
+}
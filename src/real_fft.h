@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+
+/*!
+Fast Fourier transform of `N` real values, `N` a power of two.
+
+The real input is packed into `N/2` complex values, transformed using a complex FFT, and then split into the `N/2 + 1`
+non-redundant bins of the real spectrum. The complex FFT is a decimation in time FFT that combines pairs of
+radix-2 stages into radix-4 butterflies, with a single radix-2 stage first if `log2(N/2)` is odd.
+
+The spectrum is held as interleaved real and imaginary parts, `spectrum[2*k]` and `spectrum[2*k + 1]` for bin `k`.
+The transforms are unnormalized: `inverse(forward(x))` gives `N*x`.
+
+The twiddle factors are calculated by the constructor. Intended for block processing, so the object is large for large `N`
+and should be allocated statically rather than on the stack.
+*/
+template <size_t N>
+class RealFFT {
+public:
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "N must be a power of two and at least 4");
+    static constexpr size_t SPECTRUM_SIZE = N + 2;
+    static constexpr size_t BIN_COUNT = N/2 + 1;
+public:
+    RealFFT();
+    //! Transforms the real values in `data` into `spectrum`, `data` is used as workspace and is overwritten.
+    void forward(std::array<float, N>& data, std::array<float, N + 2>& spectrum) const;
+    //! Transforms `spectrum` into real values in `data`, scaled by `N`.
+    void inverse(const std::array<float, N + 2>& spectrum, std::array<float, N>& data) const;
+private:
+    static constexpr size_t M = N/2; // size of the complex FFT
+    template <bool INVERSE>
+    void complex_fft(float* data) const;
+private:
+    // w[k] = exp(-2*PI*i*k/N), for k in range [0, N/2)
+    std::array<float, N/2> _cos {};
+    std::array<float, N/2> _sin {};
+};
+
+template <size_t N>
+RealFFT<N>::RealFFT()
+{
+    constexpr double PI = 3.14159265358979323846;
+    for (size_t k = 0; k < N/2; ++k) {
+        const double angle = 2.0*PI*static_cast<double>(k)/static_cast<double>(N);
+        _cos[k] = static_cast<float>(std::cos(angle));
+        _sin[k] = static_cast<float>(std::sin(angle));
+    }
+}
+
+/*!
+In-place complex FFT of the `M` interleaved complex values in `data`.
+*/
+template <size_t N>
+template <bool INVERSE>
+void RealFFT<N>::complex_fft(float* data) const
+{
+    // bit reversal permutation
+    for (size_t ii = 1, jj = 0; ii < M; ++ii) {
+        size_t bit = M >> 1U;
+        for (; jj & bit; bit >>= 1U) {
+            jj ^= bit;
+        }
+        jj ^= bit;
+        if (ii < jj) {
+            std::swap(data[2*ii], data[2*jj]);
+            std::swap(data[2*ii + 1], data[2*jj + 1]);
+        }
+    }
+
+    size_t h = 1; // half size of the first stage
+    // if log2(M) is odd, start with a radix-2 stage, which has no twiddle factors
+    if constexpr ((M & 0x55555555U) == 0 && M > 1) {
+        for (size_t ii = 0; ii < 2*M; ii += 4) {
+            const float re = data[ii + 2];
+            const float im = data[ii + 3];
+            data[ii + 2] = data[ii] - re;
+            data[ii + 3] = data[ii + 1] - im;
+            data[ii] += re;
+            data[ii + 1] += im;
+        }
+        h = 2;
+    }
+    // radix-4 butterflies, each combining the radix-2 stages of half size h and 2h
+    constexpr float SIGN = INVERSE ? -1.0F : 1.0F;
+    for (; h < M; h *= 4) {
+        const size_t stride = N/(4*h); // twiddle index stride for w(4h)^j
+        for (size_t group = 0; group < M; group += 4*h) {
+            for (size_t j = 0; j < h; ++j) {
+                const float w4_re = _cos[j*stride];
+                const float w4_im = -SIGN*_sin[j*stride];
+                const float w2_re = _cos[2*j*stride];
+                const float w2_im = -SIGN*_sin[2*j*stride];
+                float* a0 = &data[2*(group + j)];
+                float* a1 = a0 + 2*h;
+                float* a2 = a1 + 2*h;
+                float* a3 = a2 + 2*h;
+                // first stage, half size h
+                const float t1_re = a1[0]*w2_re - a1[1]*w2_im;
+                const float t1_im = a1[0]*w2_im + a1[1]*w2_re;
+                const float t3_re = a3[0]*w2_re - a3[1]*w2_im;
+                const float t3_im = a3[0]*w2_im + a3[1]*w2_re;
+                const float b0_re = a0[0] + t1_re;
+                const float b0_im = a0[1] + t1_im;
+                const float b1_re = a0[0] - t1_re;
+                const float b1_im = a0[1] - t1_im;
+                const float b2_re = a2[0] + t3_re;
+                const float b2_im = a2[1] + t3_im;
+                const float b3_re = a2[0] - t3_re;
+                const float b3_im = a2[1] - t3_im;
+                // second stage, half size 2h, the twiddle for the odd outputs is w(4h)^(j+h) = w(4h)^j*(-i), or *(+i) for the inverse
+                const float u2_re = b2_re*w4_re - b2_im*w4_im;
+                const float u2_im = b2_re*w4_im + b2_im*w4_re;
+                const float v_re = b3_re*w4_re - b3_im*w4_im;
+                const float v_im = b3_re*w4_im + b3_im*w4_re;
+                const float u3_re = SIGN*v_im;
+                const float u3_im = -SIGN*v_re;
+                a0[0] = b0_re + u2_re;
+                a0[1] = b0_im + u2_im;
+                a2[0] = b0_re - u2_re;
+                a2[1] = b0_im - u2_im;
+                a1[0] = b1_re + u3_re;
+                a1[1] = b1_im + u3_im;
+                a3[0] = b1_re - u3_re;
+                a3[1] = b1_im - u3_im;
+            }
+        }
+    }
+}
+
+/*!
+The even samples are packed into the real parts and the odd samples into the imaginary parts, so `z[n] = x[2n] + i*x[2n+1]`.
+With `Z = FFT(z)`, the even and odd spectra are `E[k] = (Z[k] + conj(Z[M-k]))/2` and `O[k] = (Z[k] - conj(Z[M-k]))/(2i)`,
+and `X[k] = E[k] + w[k]*O[k]`.
+*/
+template <size_t N>
+void RealFFT<N>::forward(std::array<float, N>& data, std::array<float, N + 2>& spectrum) const
+{
+    complex_fft<false>(&data[0]);
+
+    spectrum[0] = data[0] + data[1];
+    spectrum[1] = 0.0F;
+    spectrum[N] = data[0] - data[1];
+    spectrum[N + 1] = 0.0F;
+    for (size_t k = 1; k <= M/2; ++k) {
+        const size_t m = M - k;
+        const float zk_re = data[2*k];
+        const float zk_im = data[2*k + 1];
+        const float zm_re = data[2*m];
+        const float zm_im = data[2*m + 1];
+        const float e_re = 0.5F*(zk_re + zm_re);
+        const float e_im = 0.5F*(zk_im - zm_im);
+        const float o_re = 0.5F*(zk_im + zm_im);
+        const float o_im = 0.5F*(zm_re - zk_re);
+        // w[k]*O[k], w[k] = cos - i*sin
+        const float wo_re = _cos[k]*o_re + _sin[k]*o_im;
+        const float wo_im = _cos[k]*o_im - _sin[k]*o_re;
+        spectrum[2*k] = e_re + wo_re;
+        spectrum[2*k + 1] = e_im + wo_im;
+        // X[M-k] = conj(E[k]) - conj(w[k]*O[k]), since w[M-k] = -conj(w[k])
+        spectrum[2*m] = e_re - wo_re;
+        spectrum[2*m + 1] = wo_im - e_im;
+    }
+}
+
+/*!
+Reverses `forward`: `E[k] = X[k] + conj(X[M-k])` and `O[k] = (X[k] - conj(X[M-k]))*conj(w[k])`, then `z = IFFT(E + i*O)`.
+*/
+template <size_t N>
+void RealFFT<N>::inverse(const std::array<float, N + 2>& spectrum, std::array<float, N>& data) const
+{
+    data[0] = spectrum[0] + spectrum[N];
+    data[1] = spectrum[0] - spectrum[N];
+    for (size_t k = 1; k <= M/2; ++k) {
+        const size_t m = M - k;
+        const float xk_re = spectrum[2*k];
+        const float xk_im = spectrum[2*k + 1];
+        const float xm_re = spectrum[2*m];
+        const float xm_im = spectrum[2*m + 1];
+        const float e_re = xk_re + xm_re;
+        const float e_im = xk_im - xm_im;
+        const float d_re = xk_re - xm_re;
+        const float d_im = xk_im + xm_im;
+        // O[k] = d*conj(w[k]), conj(w[k]) = cos + i*sin
+        const float o_re = d_re*_cos[k] - d_im*_sin[k];
+        const float o_im = d_re*_sin[k] + d_im*_cos[k];
+        // Z[k] = E[k] + i*O[k], Z[M-k] = conj(E[k]) + i*conj(O[k])
+        data[2*k] = e_re - o_im;
+        data[2*k + 1] = e_im + o_re;
+        data[2*m] = e_re + o_im;
+        data[2*m + 1] = o_re - e_im;
+    }
+    complex_fft<true>(&data[0]);
+}
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "filter_simd.h"
+#include "filter_sum.h"
+
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstring>
 
@@ -88,8 +93,12 @@ inline void RollingBuffer<T, C>::push_back(const T& value)
 Static rolling buffer of type T and capacity C.
 Items are pushed on the back and, once the buffer is full, items just fall off the front.
 Maintains sum of items in buffer.
+
+The sum is accumulated using the `SUM` policy, see filter_sum.h. The default, `SumPlain<T>`, is fastest, but for floating point `T`
+the sum drifts from the true sum over a long run, unless `recalculate_sum()` is called, which is O(C).
+Use `SumNeumaier<T>` for floating point `T`, or `SumInteger<T>` for integer `T`, for a sum that does not drift, in O(1) per item.
 */
-template <typename T, size_t C>
+template <typename T, size_t C, typename SUM = SumPlain<T>>
 class RollingBufferWithSum {
 public:
     RollingBufferWithSum() : _begin(0), _end(0), _size(0) {}
@@ -116,8 +125,9 @@ public:
         }
     }
     size_t capacity() const { return CAPACITY; }
-    T sum() const { return _sum; }
-    T recalculate_sum();
+    using sum_t = typename SUM::sum_t;
+    sum_t sum() const { return _sum.sum(); }
+    sum_t recalculate_sum();
 
     class Iterator {
     public:
@@ -137,20 +147,20 @@ private:
     size_t _begin; //!< The virtual beginning of the rolling buffer.
     size_t _end;   //!< The virtual end of the rolling buffer (one behind the last element).
     size_t _size;  //!< The number of items in the rolling buffer.
-    T _sum {};
+    SUM _sum {};
     std::array<T, CAPACITY + 1> _buffer {}; // need one spare empty cell so we can avoid _end == _begin when full
 };
 
-template <typename T, size_t C>
-inline void RollingBufferWithSum<T, C>::push_back(const T& value)
+template <typename T, size_t C, typename SUM>
+inline void RollingBufferWithSum<T, C, SUM>::push_back(const T& value)
 {
-    _sum += value;
+    _sum.add(value);
     _buffer[_end] = value; // sizeof(_buffer) = CAPACITY + 1, so always OK to store value at _end
     ++_end;
 
     if (_size >= capacity()) {//[[likely]]
         // buffer is full, so don't increment size, instead drop items off front by incrementing _begin
-        _sum -= _buffer[_begin];
+        _sum.subtract(_buffer[_begin]);
         ++_begin;
         // wrap _begin if required
         if (_begin > capacity()) {
@@ -165,12 +175,236 @@ inline void RollingBufferWithSum<T, C>::push_back(const T& value)
     }
 }
 
-template <typename T, size_t C>
-inline T RollingBufferWithSum<T, C>::recalculate_sum()
+template <typename T, size_t C, typename SUM>
+inline typename RollingBufferWithSum<T, C, SUM>::sum_t RollingBufferWithSum<T, C, SUM>::recalculate_sum()
 {
-    _sum = 0;
+    _sum.reset();
     for (auto it = begin(); it != end(); ++it) {
-        _sum += *it;
+        _sum.add(*it);
+    }
+    return _sum.sum();
+}
+
+/*!
+Tracks the minimum and maximum of the last C items pushed, in O(1) amortized time per item.
+Items are pushed on the back and, once C items have been pushed, items just fall off the front, as for `RollingBuffer`.
+
+Each of the minimum and maximum is tracked with a monotonic deque: a queue of the items that could still become the extreme value,
+which is kept sorted by removing, on each push, the items from the back that the new item supersedes.
+The extreme value is then always at the front of its deque, and the front is removed when it falls out of the window.
+Each item is added to and removed from each deque at most once.
+
+The deques are held in fixed size arrays, so no memory is allocated. `min()` and `max()` return `T{}` if no items have been pushed.
+*/
+template <typename T, size_t C>
+class RollingMinMax {
+public:
+    static_assert(C >= 1, "C must be at least 1");
+    RollingMinMax() = default;
+private:
+    static constexpr size_t CAPACITY = C;
+public:
+    size_t size() const { return _size; }
+    bool is_empty() const { return _size == 0; }
+    size_t capacity() const { return CAPACITY; }
+    void push_back(const T& value);
+    const T& min() const { return _min.front(); }
+    const T& max() const { return _max.front(); }
+    T range() const { return max() - min(); }
+private:
+    //! Monotonic deque of up to C items in a ring buffer, decreasing from the front if MAX is true, otherwise increasing.
+    template <bool MAX>
+    class MonotonicDeque {
+    public:
+        const T& front() const { return _items[_begin].value; }
+        void push_back(const T& value, size_t sequence, size_t oldest_sequence) {
+            // at most one item falls out of the window per push
+            if (_size > 0 && _items[_begin].sequence < oldest_sequence) {
+                _begin = wrap(_begin + 1);
+                --_size;
+            }
+            // remove the items the new value supersedes
+            while (_size > 0) {
+                const size_t back = wrap(_begin + _size - 1);
+                if (MAX ? _items[back].value > value : _items[back].value < value) {
+                    break;
+                }
+                --_size;
+            }
+            _items[wrap(_begin + _size)] = item_t { value, sequence };
+            ++_size;
+        }
+    private:
+        //! indices are at most `2*CAPACITY - 1`, so a subtraction is enough to wrap them
+        static size_t wrap(size_t index) { return index >= CAPACITY ? index - CAPACITY : index; }
+        struct item_t {
+            T value;
+            size_t sequence;
+        };
+        size_t _begin {0};
+        size_t _size {0};
+        std::array<item_t, CAPACITY> _items {};
+    };
+private:
+    size_t _size {0};
+    size_t _sequence {0}; //!< number of items pushed
+    MonotonicDeque<false> _min {};
+    MonotonicDeque<true> _max {};
+};
+
+template <typename T, size_t C>
+void RollingMinMax<T, C>::push_back(const T& value)
+{
+    if (_size < capacity()) {
+        ++_size;
+    }
+    const size_t sequence = _sequence++;
+    const size_t oldest_sequence = sequence + 1 - _size;
+    _min.push_back(value, sequence, oldest_sequence);
+    _max.push_back(value, sequence, oldest_sequence);
+}
+
+
+/*!
+Static rolling buffer of type T and capacity C, which maintains the mean, variance, standard deviation and RMS of the items in the buffer in O(1) per item.
+T may be `float` or a vector of floats such as `xyz_t`, in which case the statistics are calculated for each component,
+using SIMD where available and enabled for T, see `FilterLaneTraits`.
+
+The statistics are held as the sum and sum of squares of the items' deviations from a shift value close to the mean,
+which avoids the cancellation of the naive sum of squares.
+Adding and removing items from these sums accumulates rounding error, so a second, fresh, set of sums is accumulated alongside,
+starting each time C items have been pushed. When it has accumulated C items it holds exactly the items in the buffer, and replaces
+the running sums, and a new fresh set is started, shifted by the current mean. So the rounding error is that of at most 2*C additions,
+however many items are pushed, and there is no O(C) recalculation.
+*/
+template <typename T, size_t C>
+class RollingBufferWithStats {
+public:
+    static_assert(C >= 1, "C must be at least 1");
+    using traits_t = FilterLaneTraits<T>;
+    using lanes_t = typename traits_t::lanes_t;
+    RollingBufferWithStats() = default;
+private:
+    static constexpr size_t CAPACITY = C;
+    struct sums_t {
+        lanes_t shift;
+        lanes_t sum; //!< sum of (item - shift)
+        lanes_t sum_squares; //!< sum of (item - shift)^2
+    };
+public:
+    size_t size() const { return _size; }
+    bool is_empty() const { return _size == 0; }
+    size_t capacity() const { return CAPACITY; }
+    void push_back(const T& value);
+    //! index 0 is the oldest item
+    const T& operator[](size_t index) const {
+        size_t pos = (_size < CAPACITY ? 0 : _next) + index;
+        if (pos >= CAPACITY) {
+            pos -= CAPACITY;
+        }
+        return _buffer[pos];
+    }
+    const T& back() const { return _buffer[_next > 0 ? _next - 1 : CAPACITY - 1]; }
+
+    T mean() const { return traits_t::from_lanes(mean_lanes()); }
+    //! Population variance, that is the mean squared deviation from the mean.
+    T variance() const { return non_negative(traits_t::from_lanes(variance_lanes())); }
+    T standard_deviation() const { return square_root(variance()); }
+    //! Root mean square, sqrt(variance + mean^2).
+    T rms() const {
+        const lanes_t mean = mean_lanes();
+        return square_root(non_negative(traits_t::from_lanes(variance_lanes() + product(mean, mean))));
+    }
+private:
+    lanes_t mean_lanes() const {
+        if (_size == 0) {
+            return lanes_t {};
+        }
+        return _running.shift + _running.sum*(1.0F/static_cast<float>(_size));
+    }
+    lanes_t variance_lanes() const {
+        if (_size == 0) {
+            return lanes_t {};
+        }
+        const float size_reciprocal = 1.0F/static_cast<float>(_size);
+        const lanes_t mean_deviation = _running.sum*size_reciprocal;
+        return _running.sum_squares*size_reciprocal - product(mean_deviation, mean_deviation);
+    }
+    static void add(sums_t& sums, const lanes_t& value) {
+        const lanes_t deviation = value - sums.shift;
+        sums.sum = sums.sum + deviation;
+        sums.sum_squares = sums.sum_squares + product(deviation, deviation);
+    }
+    static void remove(sums_t& sums, const lanes_t& value) {
+        const lanes_t deviation = value - sums.shift;
+        sums.sum = sums.sum - deviation;
+        sums.sum_squares = sums.sum_squares - product(deviation, deviation);
+    }
+    //! component by component product
+    static lanes_t product(const lanes_t& a, const lanes_t& b) {
+        if constexpr (FilterVector3<lanes_t>) {
+            lanes_t result = a;
+            result.x = a.x*b.x;
+            result.y = a.y*b.y;
+            result.z = a.z*b.z;
+            if constexpr (FilterVector4<lanes_t>) {
+                result.w = a.w*b.w;
+            }
+            return result;
+        } else {
+            return a*b;
+        }
+    }
+    template <typename F>
+    static T componentwise(const T& value, F fn) {
+        if constexpr (FilterVector3<T>) {
+            T result = value;
+            result.x = fn(value.x);
+            result.y = fn(value.y);
+            result.z = fn(value.z);
+            if constexpr (FilterVector4<T>) {
+                result.w = fn(value.w);
+            }
+            return result;
+        } else {
+            return fn(value);
+        }
+    }
+    //! rounding can give a slightly negative variance when all the items are almost equal
+    static T non_negative(const T& value) { return componentwise(value, [](float component) { return std::max(component, 0.0F); }); }
+    static T square_root(const T& value) { return componentwise(value, [](float component) { return std::sqrt(component); }); }
+private:
+    size_t _next {0}; //!< position of the next item, once the buffer is full this is the oldest item
+    size_t _size {0};
+    size_t _fresh_count {0}; //!< number of items in the fresh sums
+    sums_t _running {};
+    sums_t _fresh {};
+    std::array<T, CAPACITY> _buffer {};
+};
+
+template <typename T, size_t C>
+void RollingBufferWithStats<T, C>::push_back(const T& value)
+{
+    const lanes_t input = traits_t::to_lanes(value);
+    add(_running, input);
+    if (_size == CAPACITY) {
+        // buffer is full, so the oldest item drops off the front
+        remove(_running, traits_t::to_lanes(_buffer[_next]));
+    } else {
+        ++_size;
+    }
+    _buffer[_next] = value;
+    ++_next;
+    if (_next == CAPACITY) {
+        _next = 0;
+    }
+
+    add(_fresh, input);
+    ++_fresh_count;
+    if (_fresh_count == CAPACITY) {
+        // the fresh sums hold exactly the items in the buffer
+        _running = _fresh;
+        _fresh = sums_t { mean_lanes(), lanes_t {}, lanes_t {} };
+        _fresh_count = 0;
     }
-    return _sum;
 }
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "filter_templates.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+
+/*!
+Bank of notch filters that track the rotation frequencies of `Motors` motors and their first `Harmonics` harmonics.
+
+Each motor and harmonic has a single notch, `BiquadFilterT<T>`, which filters all the components of `T` (eg the three axes of an `xyz_t` gyro reading),
+so for 3 or 4 component vectors opted in to lane packing all the axes are filtered in a single SIMD pass, see `FilterLaneTraits`, and each notch frequency
+change is a single coefficient update, rather than one per axis.
+The notches are applied in series, and the input is converted to lanes once, rather than once per notch.
+
+When a motor frequency is set, `sin` and `cos` of the fundamental are calculated once, and those of the harmonics by the Chebyshev recurrence
+    sin(n*w) = 2*cos(w)*sin((n-1)*w) - sin((n-2)*w)
+    2*cos(n*w) = 2*cos(w)*2*cos((n-1)*w) - 2*cos((n-2)*w)
+and passed to `set_notch_frequency_weighted(sin_omega, two_cos_omega, weight)`.
+
+The notch weights fade in linearly from zero at `min_frequency_hz` to one at `min_frequency_hz + fade_range_hz`, so notches are not switched abruptly
+on and off as the motors slow down. Motor frequencies below `min_frequency_hz` are clamped to it.
+Similarly harmonics fade out as they approach `0.48` of the sample rate, and are disabled above it.
+*/
+template <typename T, size_t Motors, size_t Harmonics>
+class RPMNotchFilterBank {
+public:
+    static_assert(Motors >= 1, "Motors must be at least 1");
+    static_assert(Harmonics >= 1, "Harmonics must be at least 1");
+    using filter_t = BiquadFilterT<T>;
+    using traits_t = typename filter_t::traits_t;
+    using lanes_t = typename filter_t::lanes_t;
+    static constexpr size_t NOTCH_COUNT = Motors*Harmonics;
+    static constexpr float MAX_FREQUENCY_FRACTION = 0.48F; //!< fraction of the sample rate above which harmonics are disabled
+public:
+    RPMNotchFilterBank() = default;
+    void init(float looptime_seconds, float q, float min_frequency_hz, float fade_range_hz);
+    void reset() { for (auto& notch : _notches) { notch.reset(); } }
+
+    template <typename TRIG = FilterTrig>
+    void set_motor_frequency(size_t motor, float frequency_hz);
+    template <typename TRIG = FilterTrig>
+    void set_motor_frequencies(const std::array<float, Motors>& frequencies_hz) {
+        for (size_t motor = 0; motor < Motors; ++motor) {
+            set_motor_frequency<TRIG>(motor, frequencies_hz[motor]);
+        }
+    }
+
+    T filter(const T& input) {
+        lanes_t value = traits_t::to_lanes(input);
+        for (auto& notch : _notches) {
+            value = notch.filter_weighted_lanes(value);
+        }
+        return traits_t::from_lanes(value);
+    }
+    void filter_block(const T* input, T* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+
+    const filter_t& get_notch(size_t motor, size_t harmonic) const { return _notches[motor*Harmonics + harmonic]; }
+    float get_weight(size_t motor, size_t harmonic) const { return get_notch(motor, harmonic).get_weight(); }
+protected:
+    std::array<filter_t, NOTCH_COUNT> _notches {};
+    float _2_pi_looptime_seconds {0.0F};
+    float _min_frequency_hz {0.0F};
+    float _max_frequency_hz {0.0F};
+    float _fade_range_reciprocal {1.0F};
+protected:
+    static constexpr float PI_F = 3.14159265358979323846F;
+};
+
+/*!
+Sets the loop time and the `q` of all the notches, and disables all the notches until their motor frequencies are set.
+`fade_range_hz` must be greater than zero.
+*/
+template <typename T, size_t Motors, size_t Harmonics>
+void RPMNotchFilterBank<T, Motors, Harmonics>::init(float looptime_seconds, float q, float min_frequency_hz, float fade_range_hz)
+{
+    assert(fade_range_hz > 0.0F && "fade range must be greater than zero");
+    _2_pi_looptime_seconds = 2.0F*PI_F*looptime_seconds;
+    _min_frequency_hz = min_frequency_hz;
+    _max_frequency_hz = MAX_FREQUENCY_FRACTION/looptime_seconds;
+    _fade_range_reciprocal = 1.0F/fade_range_hz;
+    for (auto& notch : _notches) {
+        notch.set_looptime(looptime_seconds);
+        notch.set_q(q);
+    }
+    for (size_t motor = 0; motor < Motors; ++motor) {
+        set_motor_frequency(motor, 0.0F);
+    }
+    reset();
+}
+
+/*!
+Sets the fundamental frequency of `motor`, updating the notches of all its harmonics using a single `TRIG::sincos`.
+*/
+template <typename T, size_t Motors, size_t Harmonics>
+template <typename TRIG>
+void RPMNotchFilterBank<T, Motors, Harmonics>::set_motor_frequency(size_t motor, float frequency_hz)
+{
+    const float fade_in = std::clamp((frequency_hz - _min_frequency_hz)*_fade_range_reciprocal, 0.0F, 1.0F);
+    const float frequency = std::max(frequency_hz, _min_frequency_hz);
+
+    float sin_omega {};
+    float cos_omega {};
+    TRIG::sincos(frequency*_2_pi_looptime_seconds, sin_omega, cos_omega);
+    const float two_cos_omega = 2.0F*cos_omega;
+
+    float sin_previous = 0.0F;
+    float two_cos_previous = 2.0F;
+    float sin_harmonic = sin_omega;
+    float two_cos_harmonic = two_cos_omega;
+    filter_t* notch = &_notches[motor*Harmonics];
+    for (size_t harmonic = 1; harmonic <= Harmonics; ++harmonic, ++notch) {
+        const float harmonic_frequency = frequency*static_cast<float>(harmonic);
+        const float fade_out = std::clamp((_max_frequency_hz - harmonic_frequency)*_fade_range_reciprocal, 0.0F, 1.0F);
+        // above the Nyquist frequency sin(n*w) is negative, which would give an unstable filter,
+        // fabs gives the stable notch at the aliased frequency, which has zero weight in any case
+        notch->set_notch_frequency_weighted(std::fabs(sin_harmonic), two_cos_harmonic, fade_in*fade_out);
+
+        const float sin_next = two_cos_omega*sin_harmonic - sin_previous;
+        const float two_cos_next = two_cos_omega*two_cos_harmonic - two_cos_previous;
+        sin_previous = sin_harmonic;
+        two_cos_previous = two_cos_harmonic;
+        sin_harmonic = sin_next;
+        two_cos_harmonic = two_cos_next;
+    }
+}
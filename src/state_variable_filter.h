@@ -0,0 +1,139 @@
+#pragma once
+
+#include "filters.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+/*!
+State variable filter, using the trapezoidal integration (zero delay feedback) form described by Andrew Simper of Cytomic,
+see [Linear Trapezoidal Integrated State Variable Filter](https://cytomic.com/files/dsp/SvfLinearTrapOptimised2.pdf).
+
+Gives lowpass, bandpass, highpass and notch outputs from a single set of state, and has the same frequency response as the
+corresponding `BiquadFilter`, but its state variables are the integrator values, rather than past inputs and outputs, so it
+remains stable and free of transients when the cutoff frequency is changed every sample.
+
+The cutoff is set using `g = tan(PI*frequency*looptime)`, which is calculated using a rational (Pade) approximation,
+with a relative error less than 2e-5 up to 0.44 of the sample rate, rising to 3e-4 at `MAX_CUTOFF_FRACTION`. All the coefficients are then calculated with a single division,
+so changing the cutoff frequency needs no trigonometric functions.
+
+The bandpass output is normalized to unity gain at the center frequency.
+*/
+class StateVariableFilter : public FilterBase {
+public:
+    enum mode_e : uint8_t { LOW_PASS, BAND_PASS, HIGH_PASS, NOTCH };
+    struct outputs_t {
+        float low_pass;
+        float band_pass;
+        float high_pass;
+        float notch;
+    };
+    struct state_t {
+        float ic1eq;
+        float ic2eq;
+    };
+    static constexpr float MAX_CUTOFF_FRACTION = 0.49F; //!< cutoff frequencies are limited to this fraction of the sample rate
+public:
+    StateVariableFilter() = default;
+    StateVariableFilter(float cutoff_frequency_hz, float looptime_seconds, float q, mode_e mode) { init(cutoff_frequency_hz, looptime_seconds, q, mode); }
+public:
+    void init(float cutoff_frequency_hz, float looptime_seconds, float q, mode_e mode) {
+        _mode = mode;
+        set_looptime(looptime_seconds);
+        set_q(q);
+        set_cutoff_frequency(cutoff_frequency_hz);
+        reset();
+    }
+    void reset() { _state.ic1eq = 0.0F; _state.ic2eq = 0.0F; }
+    void flush_denormals() { FilterDenormal::flush(_state.ic1eq); FilterDenormal::flush(_state.ic2eq); } //!< see FilterDenormal
+    //! Sets the filter so that the lowpass and notch outputs equal the input, this is the limit as the cutoff frequency tends to infinity.
+    void set_to_passthrough() { _a1 = 0.0F; _a2 = 0.0F; _a3 = 1.0F; _mode = LOW_PASS; reset(); }
+
+    void set_mode(mode_e mode) { _mode = mode; }
+    mode_e get_mode() const { return _mode; }
+    void set_looptime(float looptime_seconds) { _pi_looptime_seconds = PI_F*looptime_seconds; }
+    //! Sets q, takes effect at the next call to `set_cutoff_frequency`.
+    void set_q(float q) { assert(q > 0.0F && "q must be greater than zero"); _k = 1.0F/q; }
+    float get_q() const { return 1.0F/_k; }
+    void set_cutoff_frequency(float cutoff_frequency_hz);
+    void set_cutoff_frequency(float cutoff_frequency_hz, float dt) { set_looptime(dt); set_cutoff_frequency(cutoff_frequency_hz); }
+    void set_cutoff_frequency_and_reset(float cutoff_frequency_hz, float dt) { set_cutoff_frequency(cutoff_frequency_hz, dt); reset(); }
+
+    //! Filters `input`, returning all the outputs.
+    outputs_t filter_all(float input) {
+        const float v3 = input - _state.ic2eq;
+        const float v1 = _a1*_state.ic1eq + _a2*v3;
+        const float v2 = _state.ic2eq + _a2*_state.ic1eq + _a3*v3;
+        _state.ic1eq = 2.0F*v1 - _state.ic1eq;
+        _state.ic2eq = 2.0F*v2 - _state.ic2eq;
+        const float notch = input - _k*v1;
+        return outputs_t { v2, _k*v1, notch - v2, notch };
+    }
+    //! Filters `input`, returning the output for the current mode.
+    float filter(float input) {
+        const outputs_t outputs = filter_all(input);
+        switch (_mode) {
+        case BAND_PASS:
+            return outputs.band_pass;
+        case HIGH_PASS:
+            return outputs.high_pass;
+        case NOTCH:
+            return outputs.notch;
+        default:
+            return outputs.low_pass;
+        }
+    }
+    virtual float filter_virtual(float input) override { return filter(input); }
+    void filter_block(const float* input, float* output, size_t count) {
+        for (size_t ii = 0; ii < count; ++ii) {
+            output[ii] = filter(input[ii]);
+        }
+    }
+    void filter_block(float* data, size_t count) { filter_block(data, data, count); } //!< in-place variant
+
+    /*!
+    Approximation to tan(x) for x in the range [0, PI/2), as a numerator and denominator, so the division can be combined with others.
+    This is the [5/4] Pade approximant, whose pole is within 1e-5 of PI/2.
+    */
+    static void tan_approximation(float x, float& numerator, float& denominator) {
+        const float x2 = x*x;
+        numerator = x*(945.0F + x2*(-105.0F + x2));
+        denominator = 945.0F + x2*(-420.0F + x2*15.0F);
+    }
+    static float tan_approximation(float x) { float numerator {}; float denominator {}; tan_approximation(x, numerator, denominator); return numerator/denominator; }
+// for testing
+    const state_t& get_state() const { return _state; }
+protected:
+    float _a1 {0.0F};
+    float _a2 {0.0F};
+    float _a3 {1.0F};
+    float _k {1.0F}; //!< 1/q
+    state_t _state {};
+    float _pi_looptime_seconds {PI_F};
+    mode_e _mode {LOW_PASS};
+protected:
+    static constexpr float PI_F = 3.14159265358979323846F;
+};
+
+/*!
+Sets the cutoff (or center) frequency, which is limited to `MAX_CUTOFF_FRACTION` of the sample rate.
+
+With `g = N/D`, the coefficients
+    a1 = 1/(1 + g*(g + k)), a2 = g*a1, a3 = g*a2
+are calculated as
+    a1 = D*D/r, a2 = N*D/r, a3 = N*N/r, where r = D*D + N*(N + k*D)
+so only a single division is needed.
+*/
+inline void StateVariableFilter::set_cutoff_frequency(float cutoff_frequency_hz)
+{
+    const float x = std::clamp(cutoff_frequency_hz*_pi_looptime_seconds, 0.0F, MAX_CUTOFF_FRACTION*PI_F);
+    float n {};
+    float d {};
+    tan_approximation(x, n, d);
+    const float r_reciprocal = 1.0F/(d*d + n*(n + _k*d));
+    _a1 = d*d*r_reciprocal;
+    _a2 = n*d*r_reciprocal;
+    _a3 = n*n*r_reciprocal;
+}
@@ -0,0 +1,268 @@
+#include "biquad_cascade.h"
+#include "biquad_filter_bank.h"
+#include "filters.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 20;
+
+std::vector<float> make_signal()
+{
+    std::vector<float> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        const float t = static_cast<float>(ii)*0.000125F; // 8kHz
+        signal[ii] = sinf(2.0F*3.14159265F*37.0F*t) + 0.25F*sinf(2.0F*3.14159265F*1200.0F*t);
+    }
+    return signal;
+}
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+} // end namespace
+
+void test_benchmark_biquad_block()
+{
+    const std::vector<float> signal = make_signal();
+    std::vector<float> per_sample(signal.size());
+    std::vector<float> block(signal.size());
+
+    BiquadFilter filter_a; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter filter_b; // NOLINT(cppcoreguidelines-init-variables)
+    filter_a.init_lowpass(100.0F, 0.000125F, 0.7071F);
+    filter_b.init_lowpass(100.0F, 0.000125F, 0.7071F);
+
+    const double ns_per_sample = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            per_sample[ii] = filter_a.filter(signal[ii]);
+        }
+    });
+    const double ns_block = nanoseconds_per_sample([&]() {
+        filter_b.filter_block(&signal[0], &block[0], signal.size());
+    });
+    printf("BiquadFilter::filter       %6.3f ns/sample\n", ns_per_sample);
+    printf("BiquadFilter::filter_block %6.3f ns/sample (%.2fx)\n", ns_block, ns_per_sample/ns_block);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, per_sample[ii], block[ii]);
+    }
+}
+void test_benchmark_biquad_filter_bank()
+{
+    // 3 axes x 4 notches, as used for dynamic notch filtering of gyro output
+    enum { CHANNEL_COUNT = 12 };
+    const std::vector<float> signal = make_signal();
+    std::array<BiquadFilter, CHANNEL_COUNT> filters {};
+    BiquadFilterBank<CHANNEL_COUNT> bank;
+    for (size_t ii = 0; ii < CHANNEL_COUNT; ++ii) {
+        const float frequency = 100.0F + 50.0F*static_cast<float>(ii);
+        filters[ii].init_notch(frequency, 0.000125F, 3.0F);
+        bank.init_notch(ii, frequency, 0.000125F, 3.0F);
+    }
+
+    std::array<float, CHANNEL_COUNT> input {};
+    std::array<float, CHANNEL_COUNT> output_filters {};
+    std::array<float, CHANNEL_COUNT> output_bank {};
+    float checksum_filters = 0.0F;
+    float checksum_bank = 0.0F;
+    const double ns_filters = nanoseconds_per_sample([&]() {
+        for (const float value : signal) {
+            input.fill(value);
+            for (size_t ii = 0; ii < CHANNEL_COUNT; ++ii) {
+                output_filters[ii] = filters[ii].filter(input[ii]);
+            }
+            checksum_filters += output_filters[CHANNEL_COUNT - 1];
+        }
+    });
+    const double ns_bank = nanoseconds_per_sample([&]() {
+        for (const float value : signal) {
+            input.fill(value);
+            bank.filter(input, output_bank);
+            checksum_bank += output_bank[CHANNEL_COUNT - 1];
+        }
+    });
+    printf("BiquadFilter[12]           %6.3f ns/step\n", ns_filters);
+    printf("BiquadFilterBank<12>       %6.3f ns/step (%.2fx)\n", ns_bank, ns_filters/ns_bank);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-2F, checksum_filters, checksum_bank);
+}
+
+void test_benchmark_biquad_cascade()
+{
+    enum { STAGE_COUNT = 4 };
+    const std::vector<float> signal = make_signal();
+    std::vector<float> output_filters(signal.size());
+    std::vector<float> output_filters_block(signal.size());
+    std::vector<float> output_cascade(signal.size());
+    std::vector<float> output_block(signal.size());
+    std::array<BiquadFilter, STAGE_COUNT> filters {};
+    std::array<BiquadFilter, STAGE_COUNT> filters_block {};
+    BiquadCascade<STAGE_COUNT> cascade; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadCascade<STAGE_COUNT> cascade_block; // NOLINT(cppcoreguidelines-init-variables)
+    for (size_t ii = 0; ii < STAGE_COUNT; ++ii) {
+        filters[ii].init_lowpass(200.0F, 0.000125F, 0.7071F);
+        filters_block[ii].init_lowpass(200.0F, 0.000125F, 0.7071F);
+        cascade.init_lowpass(ii, 200.0F, 0.000125F, 0.7071F);
+        cascade_block.init_lowpass(ii, 200.0F, 0.000125F, 0.7071F);
+    }
+
+    const double ns_filters = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            float value = signal[ii];
+            for (auto& filter : filters) {
+                value = filter.filter(value);
+            }
+            output_filters[ii] = value;
+        }
+    });
+    const double ns_filters_block = nanoseconds_per_sample([&]() {
+        filters_block[0].filter_block(&signal[0], &output_filters_block[0], signal.size());
+        for (size_t ii = 1; ii < STAGE_COUNT; ++ii) {
+            filters_block[ii].filter_block(&output_filters_block[0], &output_filters_block[0], signal.size());
+        }
+    });
+    const double ns_cascade = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_cascade[ii] = cascade.filter(signal[ii]);
+        }
+    });
+    const double ns_block = nanoseconds_per_sample([&]() {
+        cascade_block.filter_block(&signal[0], &output_block[0], signal.size());
+    });
+    printf("BiquadFilter x 4 chained   %6.3f ns/sample\n", ns_filters);
+    printf("BiquadFilter x 4 blocks    %6.3f ns/sample\n", ns_filters_block);
+    printf("BiquadCascade<4>::filter   %6.3f ns/sample (%.2fx)\n", ns_cascade, ns_filters/ns_cascade);
+    printf("BiquadCascade<4>::block    %6.3f ns/sample (%.2fx blocks)\n", ns_block, ns_filters_block/ns_block);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_filters[ii], output_filters_block[ii]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_filters[ii], output_cascade[ii]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_filters[ii], output_block[ii]);
+    }
+}
+
+void test_benchmark_biquad_ramp()
+{
+    // notch swept between 100Hz and 300Hz four times a second, as when tracking motor speed,
+    // with the target frequency updated every 32 samples and a 200Hz tone in the input
+    enum { UPDATE_INTERVAL = 32 };
+    std::vector<float> signal = make_signal();
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal[ii] += sinf(2.0F*3.14159265F*200.0F*static_cast<float>(ii)*0.000125F);
+    }
+    auto update_frequency = [](size_t update) { return 200.0F + 100.0F*sinf(2.0F*3.14159265F*static_cast<float>(update)/62.5F); };
+
+    // reference: coefficients recalculated every sample along the frequency ramp between updates
+    auto run_reference = [&](BiquadFilter& filter, float* output) {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            const size_t update = ii/UPDATE_INTERVAL;
+            const float fraction = static_cast<float>(ii % UPDATE_INTERVAL + 1)/static_cast<float>(UPDATE_INTERVAL);
+            const float previous = update_frequency(update == 0 ? 0 : update - 1);
+            filter.set_notch_frequency(previous + (update_frequency(update) - previous)*fraction);
+            output[ii] = filter.filter(signal[ii]);
+        }
+    };
+    // coefficients jump to the new target every UPDATE_INTERVAL samples
+    auto run_jump = [&](BiquadFilter& filter, float* output) {
+        for (size_t ii = 0; ii < signal.size(); ii += UPDATE_INTERVAL) {
+            filter.set_notch_frequency(update_frequency(ii/UPDATE_INTERVAL));
+            filter.filter_block(&signal[ii], &output[ii], UPDATE_INTERVAL);
+        }
+    };
+    // coefficients ramp to the new target over UPDATE_INTERVAL samples
+    auto run_ramp = [&](BiquadFilterRamped& filter, float* output) {
+        for (size_t ii = 0; ii < signal.size(); ii += UPDATE_INTERVAL) {
+            filter.set_target_notch_frequency(update_frequency(ii/UPDATE_INTERVAL));
+            filter.filter_block(&signal[ii], &output[ii], UPDATE_INTERVAL);
+        }
+    };
+
+    std::vector<float> output_reference(signal.size());
+    std::vector<float> output_jump(signal.size());
+    std::vector<float> output_ramp(signal.size());
+    BiquadFilter reference; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter jump; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilterRamped ramp; // NOLINT(cppcoreguidelines-init-variables)
+    reference.init_notch(update_frequency(0), 0.000125F, 3.0F);
+    jump.init_notch(update_frequency(0), 0.000125F, 3.0F);
+    ramp.init_notch(update_frequency(0), 0.000125F, 3.0F);
+    ramp.set_ramp_samples(UPDATE_INTERVAL);
+    const double ns_reference = nanoseconds_per_sample([&]() { reference.reset(); run_reference(reference, &output_reference[0]); });
+    const double ns_jump = nanoseconds_per_sample([&]() { jump.reset(); jump.set_notch_frequency(update_frequency(0)); run_jump(jump, &output_jump[0]); });
+    const double ns_ramp = nanoseconds_per_sample([&]() { ramp.reset(); ramp.set_notch_frequency(update_frequency(0)); run_ramp(ramp, &output_ramp[0]); });
+
+    float error_jump = 0.0F;
+    float error_ramp = 0.0F;
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        error_jump = std::max(error_jump, std::fabs(output_jump[ii] - output_reference[ii]));
+        error_ramp = std::max(error_ramp, std::fabs(output_ramp[ii] - output_reference[ii]));
+    }
+    printf("notch sweep, recalculated every sample %6.3f ns/sample\n", ns_reference);
+    printf("notch sweep, jump every %2d samples     %6.3f ns/sample, max deviation %.5f\n", UPDATE_INTERVAL, ns_jump, static_cast<double>(error_jump));
+    printf("notch sweep, ramp over %2d samples      %6.3f ns/sample, max deviation %.5f\n", UPDATE_INTERVAL, ns_ramp, static_cast<double>(error_ramp));
+
+    TEST_ASSERT_TRUE(error_ramp < error_jump);
+}
+
+void test_benchmark_biquad_advance()
+{
+    const std::vector<float> signal = make_signal();
+    constexpr size_t STRIDE = 64; // one catch-up every STRIDE samples of the signal, so the loop version completes in reasonable time
+
+    for (size_t count : { 4U, 64U, 1024U }) {
+        BiquadFilter looped; // NOLINT(cppcoreguidelines-init-variables)
+        BiquadFilter advanced; // NOLINT(cppcoreguidelines-init-variables)
+        looped.init_lowpass(100.0F, 0.000125F, 0.7071F);
+        advanced.init_lowpass(100.0F, 0.000125F, 0.7071F);
+        float output_looped = 0.0F;
+        float output_advanced = 0.0F;
+        const double ns_looped = STRIDE*nanoseconds_per_sample([&]() {
+            for (size_t ii = 0; ii < signal.size(); ii += STRIDE) {
+                for (size_t jj = 0; jj < count; ++jj) {
+                    output_looped = looped.filter(signal[ii]);
+                }
+            }
+        });
+        const double ns_advanced = STRIDE*nanoseconds_per_sample([&]() {
+            for (size_t ii = 0; ii < signal.size(); ii += STRIDE) {
+                output_advanced = advanced.advance(signal[ii], count);
+            }
+        });
+        printf("catch up %4u samples, filter loop %9.1f ns, advance %6.1f ns (%.1fx)\n",
+            static_cast<unsigned>(count), ns_looped, ns_advanced, ns_looped/ns_advanced);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_looped, output_advanced);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_biquad_block);
+    RUN_TEST(test_benchmark_biquad_filter_bank);
+    RUN_TEST(test_benchmark_biquad_cascade);
+    RUN_TEST(test_benchmark_biquad_ramp);
+    RUN_TEST(test_benchmark_biquad_advance);
+
+    UNITY_END();
+}
@@ -0,0 +1,84 @@
+#include "cic_decimator.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 20;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+template <size_t RATIO>
+void benchmark_cic()
+{
+    // raw 16 bit ADC samples
+    std::vector<int16_t> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal[ii] = static_cast<int16_t>(20000.0F*sinf(0.001F*static_cast<float>(ii)) + static_cast<float>((ii*7919) % 2001) - 1000.0F);
+    }
+
+    FilterMovingAverage<RATIO> moving_average;
+    std::vector<float> output_moving_average(signal.size()/RATIO);
+    const double ns_moving_average = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            const float output = moving_average.filter(static_cast<float>(signal[ii]));
+            if (ii % RATIO == RATIO - 1) {
+                output_moving_average[ii/RATIO] = output;
+            }
+        }
+    });
+    CICDecimator<1, RATIO> cic1;
+    std::vector<float> output_cic1(signal.size()/RATIO);
+    const double ns_cic1 = nanoseconds_per_sample([&]() {
+        cic1.filter_block(&signal[0], &output_cic1[0], signal.size());
+    });
+    CICDecimator<3, RATIO> cic3;
+    std::vector<float> output_cic3(signal.size()/RATIO);
+    const double ns_cic3 = nanoseconds_per_sample([&]() {
+        cic3.filter_block(&signal[0], &output_cic3[0], signal.size());
+    });
+    printf("FilterMovingAverage<%2u>, keep 1 in %2u  %8.3f ns/input sample\n", static_cast<unsigned>(RATIO), static_cast<unsigned>(RATIO), ns_moving_average);
+    printf("CICDecimator<1, %2u>::filter_block     %8.3f ns/input sample (%.2fx)\n", static_cast<unsigned>(RATIO), ns_cic1, ns_moving_average/ns_cic1);
+    printf("CICDecimator<3, %2u>::filter_block     %8.3f ns/input sample (%.2fx)\n", static_cast<unsigned>(RATIO), ns_cic3, ns_moving_average/ns_cic3);
+
+    // after the first repeat the moving average has the same history as the CIC
+    for (size_t ii = 0; ii < output_cic1.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(0.05F, output_moving_average[ii], output_cic1[ii]);
+    }
+}
+} // end namespace
+
+void test_benchmark_cic_decimator()
+{
+    benchmark_cic<8>();
+    benchmark_cic<32>();
+    benchmark_cic<64>();
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_cic_decimator);
+
+    UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include "filters.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t WINDOW_SIZE = 4096;
+constexpr size_t WINDOW_COUNT = 8;
+constexpr size_t FILTER_COUNT = 8;
+
+enum mode_e { PLAIN, GUARD, FLUSH };
+
+struct filters_t {
+    std::array<BiquadFilter, FILTER_COUNT> biquads;
+    std::array<PowerTransferFilter3, FILTER_COUNT> pt3s;
+    filters_t() {
+        for (size_t ii = 0; ii < FILTER_COUNT; ++ii) {
+            biquads[ii].init_lowpass(20.0F + 10.0F*static_cast<float>(ii), 0.001F, 0.7071F);
+            pt3s[ii].set_cutoff_frequency(20.0F + 10.0F*static_cast<float>(ii), 0.001F);
+        }
+    }
+    float filter(float input) {
+        float sum = 0.0F;
+        for (size_t ii = 0; ii < FILTER_COUNT; ++ii) {
+            sum += biquads[ii].filter(input) + pt3s[ii].filter(input);
+        }
+        return sum;
+    }
+    void flush_denormals() {
+        for (size_t ii = 0; ii < FILTER_COUNT; ++ii) {
+            biquads[ii].flush_denormals();
+            pt3s[ii].flush_denormals();
+        }
+    }
+};
+
+/*!
+Runs an input that decays exponentially during the first window and is zero thereafter through the filters, and returns the time per sample, in nanoseconds, for each window.
+*/
+std::array<double, WINDOW_COUNT> run(mode_e mode)
+{
+    filters_t filters;
+    std::array<double, WINDOW_COUNT> ns {};
+    float input = 1.0F;
+    volatile float sink = 0.0F;
+    for (size_t window = 0; window < WINDOW_COUNT; ++window) {
+        const auto start = std::chrono::steady_clock::now();
+        if (mode == GUARD) {
+            const DenormalGuard guard;
+            for (size_t ii = 0; ii < WINDOW_SIZE; ++ii) {
+                sink = filters.filter(input);
+                input = window == 0 ? input*0.99F : 0.0F;
+            }
+        } else {
+            for (size_t ii = 0; ii < WINDOW_SIZE; ++ii) {
+                sink = filters.filter(input);
+                input = window == 0 ? input*0.99F : 0.0F;
+                if (mode == FLUSH) {
+                    filters.flush_denormals();
+                }
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        ns[window] = elapsed/static_cast<double>(WINDOW_SIZE*FILTER_COUNT*2);
+    }
+    (void)sink;
+    return ns;
+}
+} // end namespace
+
+void test_benchmark_denormal()
+{
+    const std::array<double, WINDOW_COUNT> plain = run(PLAIN);
+    const std::array<double, WINDOW_COUNT> guard = run(GUARD);
+    const std::array<double, WINDOW_COUNT> flush = run(FLUSH);
+    printf("ns/sample/filter for %u biquads and %u PowerTransferFilter3s, input decaying to zero, in windows of %u samples\n",
+        static_cast<unsigned>(FILTER_COUNT), static_cast<unsigned>(FILTER_COUNT), static_cast<unsigned>(WINDOW_SIZE));
+    printf("window   plain   DenormalGuard   flush_denormals\n");
+    for (size_t window = 0; window < WINDOW_COUNT; ++window) {
+        printf("%6u %7.3f %15.3f %17.3f\n", static_cast<unsigned>(window), plain[window], guard[window], flush[window]);
+    }
+    // outputs must decay to exactly zero with flushing
+    filters_t filters;
+    filters.filter(1.0F);
+    for (size_t ii = 0; ii < WINDOW_SIZE*2; ++ii) {
+        filters.filter(0.0F);
+        filters.flush_denormals();
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filters.filter(0.0F));
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_denormal);
+
+    UNITY_END();
+}
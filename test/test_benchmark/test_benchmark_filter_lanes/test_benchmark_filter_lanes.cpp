@@ -0,0 +1,153 @@
+#include "filter_templates.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+#include <xyz_type.h>
+
+//! The lane packed filters under test, compared against `xyz_scalar_t` below.
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 20;
+
+//! Copy of `xyz_t`, which is not opted in to lane packing, so is filtered by the generic template using its arithmetic operators.
+struct xyz_scalar_t {
+    float x;
+    float y;
+    float z;
+    xyz_scalar_t operator+(const xyz_scalar_t& v) const { return xyz_scalar_t{x + v.x, y + v.y, z + v.z}; }
+    xyz_scalar_t operator-(const xyz_scalar_t& v) const { return xyz_scalar_t{x - v.x, y - v.y, z - v.z}; }
+    xyz_scalar_t operator*(float k) const { return xyz_scalar_t{x*k, y*k, z*k}; }
+};
+
+std::vector<xyz_t> make_signal()
+{
+    std::vector<xyz_t> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        const float t = static_cast<float>(ii)*0.001F;
+        signal[ii] = xyz_t { sinf(2.0F*3.14159265F*7.0F*t), cosf(2.0F*3.14159265F*13.0F*t), 0.25F*sinf(2.0F*3.14159265F*200.0F*t) };
+    }
+    return signal;
+}
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+} // end namespace
+
+void test_benchmark_biquad_lanes()
+{
+    const std::vector<xyz_t> signal = make_signal();
+    std::vector<xyz_scalar_t> signal_scalar(signal.size());
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal_scalar[ii] = xyz_scalar_t { signal[ii].x, signal[ii].y, signal[ii].z };
+    }
+
+    BiquadFilterT<xyz_scalar_t> scalar;
+    scalar.init_lowpass(80.0F, 0.001F, 0.7071F);
+    std::vector<xyz_scalar_t> output_scalar(signal.size());
+    const double ns_scalar = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_scalar[ii] = scalar.filter(signal_scalar[ii]);
+        }
+    });
+    BiquadFilterT<xyz_t> lanes;
+    lanes.init_lowpass(80.0F, 0.001F, 0.7071F);
+    std::vector<xyz_t> output_lanes(signal.size());
+    const double ns_lanes = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_lanes[ii] = lanes.filter(signal[ii]);
+        }
+    });
+    BiquadFilterT<xyz_scalar_t> scalar_block;
+    scalar_block.init_lowpass(80.0F, 0.001F, 0.7071F);
+    const double ns_scalar_block = nanoseconds_per_sample([&]() {
+        scalar_block.filter_block(&signal_scalar[0], &output_scalar[0], signal.size());
+    });
+    BiquadFilterT<xyz_t> lanes_block;
+    lanes_block.init_lowpass(80.0F, 0.001F, 0.7071F);
+    const double ns_lanes_block = nanoseconds_per_sample([&]() {
+        lanes_block.filter_block(&signal[0], &output_lanes[0], signal.size());
+    });
+    printf("BiquadFilterT<xyz_t> generic               %8.3f ns/sample\n", ns_scalar);
+    printf("BiquadFilterT<xyz_t> lanes                 %8.3f ns/sample (%.2fx)\n", ns_lanes, ns_scalar/ns_lanes);
+    printf("BiquadFilterT<xyz_t> generic filter_block  %8.3f ns/sample\n", ns_scalar_block);
+    printf("BiquadFilterT<xyz_t> lanes filter_block    %8.3f ns/sample (%.2fx)\n", ns_lanes_block, ns_scalar_block/ns_lanes_block);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, output_scalar[ii].x, output_lanes[ii].x);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, output_scalar[ii].z, output_lanes[ii].z);
+    }
+}
+
+void test_benchmark_power_transfer_lanes()
+{
+    const std::vector<xyz_t> signal = make_signal();
+    std::vector<xyz_scalar_t> signal_scalar(signal.size());
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal_scalar[ii] = xyz_scalar_t { signal[ii].x, signal[ii].y, signal[ii].z };
+    }
+
+    PowerTransferFilter1T<xyz_scalar_t> scalar1(0.1F);
+    std::vector<xyz_scalar_t> output_scalar(signal.size());
+    const double ns_scalar1 = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_scalar[ii] = scalar1.filter(signal_scalar[ii]);
+        }
+    });
+    PowerTransferFilter1T<xyz_t> lanes1(0.1F);
+    std::vector<xyz_t> output_lanes(signal.size());
+    const double ns_lanes1 = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_lanes[ii] = lanes1.filter(signal[ii]);
+        }
+    });
+    PowerTransferFilter3T<xyz_scalar_t> scalar3(0.1F);
+    const double ns_scalar3 = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_scalar[ii] = scalar3.filter(signal_scalar[ii]);
+        }
+    });
+    PowerTransferFilter3T<xyz_t> lanes3(0.1F);
+    const double ns_lanes3 = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            output_lanes[ii] = lanes3.filter(signal[ii]);
+        }
+    });
+    printf("PowerTransferFilter1T<xyz_t> generic       %8.3f ns/sample\n", ns_scalar1);
+    printf("PowerTransferFilter1T<xyz_t> lanes         %8.3f ns/sample (%.2fx)\n", ns_lanes1, ns_scalar1/ns_lanes1);
+    printf("PowerTransferFilter3T<xyz_t> generic       %8.3f ns/sample\n", ns_scalar3);
+    printf("PowerTransferFilter3T<xyz_t> lanes         %8.3f ns/sample (%.2fx)\n", ns_lanes3, ns_scalar3/ns_lanes3);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, output_scalar[ii].y, output_lanes[ii].y);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_biquad_lanes);
+    RUN_TEST(test_benchmark_power_transfer_lanes);
+
+    UNITY_END();
+}
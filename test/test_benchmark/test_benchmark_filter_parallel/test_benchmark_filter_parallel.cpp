@@ -0,0 +1,83 @@
+#include "filter_parallel.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 22U; // about 70 minutes of a 1kHz log
+constexpr int REPEATS = 5;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+template <typename FILTER>
+void benchmark_parallel(const char* name, const FILTER& filter, const std::vector<float>& input)
+{
+    std::vector<float> output_serial(SAMPLE_COUNT);
+    std::vector<float> output_parallel(SAMPLE_COUNT);
+    const double ns_serial = nanoseconds_per_sample([&]() {
+        FILTER serial = filter;
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_serial[ii] = serial.filter(input[ii]);
+        }
+    });
+    printf("%s serial            %8.3f ns/sample\n", name, ns_serial);
+
+    const size_t hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+    for (const size_t thread_count : { static_cast<size_t>(1), static_cast<size_t>(2), static_cast<size_t>(4), hardware_threads }) {
+        FilterThreadPool pool(thread_count);
+        FilterParallel<FILTER> parallel(pool);
+        const double ns_parallel = nanoseconds_per_sample([&]() {
+            FILTER filter_parallel = filter;
+            parallel.filter_block(filter_parallel, input.data(), output_parallel.data(), SAMPLE_COUNT);
+        });
+        printf("%s %2zu threads        %8.3f ns/sample (%.2fx)\n", name, thread_count, ns_parallel, ns_serial/ns_parallel);
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ii += 997) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_serial[ii], output_parallel[ii]);
+        }
+    }
+}
+} // end namespace
+
+void test_benchmark_filter_parallel()
+{
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::vector<float> input(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        const float t = static_cast<float>(ii);
+        input[ii] = sinf(0.001F*t) + 0.1F*sinf(0.9F*t);
+    }
+
+    PowerTransferFilter3 pt3(100.0F, 0.001F);
+    benchmark_parallel("PowerTransferFilter3", pt3, input);
+
+    BiquadFilter biquad;
+    biquad.init_lowpass(100.0F, 0.001F, 0.7071F);
+    benchmark_parallel("BiquadFilter        ", biquad, input);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_filter_parallel);
+
+    UNITY_END();
+}
@@ -0,0 +1,162 @@
+#include "fir_filter.h"
+#include "fir_filter_fft.h"
+#include "polyphase_filter.h"
+#include "rolling_buffer.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/static_cast<double>(SAMPLE_COUNT);
+}
+
+template <size_t TAPS>
+void benchmark_fir()
+{
+    std::vector<float> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal[ii] = sinf(0.01F*static_cast<float>(ii)) + 0.1F*sinf(1.3F*static_cast<float>(ii));
+    }
+    FIRFilter<TAPS> filter;
+    filter.init_lowpass(40.0F, 0.001F);
+    const std::array<float, TAPS> coefficients = filter.get_coefficients();
+
+    // naive convolution over a RollingBuffer, using the modulo-indexed operator[]
+    RollingBuffer<float, TAPS> history;
+    for (size_t ii = 0; ii < TAPS; ++ii) {
+        history.push_back(0.0F);
+    }
+    std::vector<float> output_naive(signal.size());
+    const double ns_naive = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            history.push_back(signal[ii]);
+            float sum = 0.0F;
+            for (size_t k = 0; k < TAPS; ++k) {
+                sum += coefficients[k]*history[TAPS - 1 - k];
+            }
+            output_naive[ii] = sum;
+        }
+    });
+    std::vector<float> output_fir(signal.size());
+    const double ns_fir = nanoseconds_per_sample([&]() {
+        filter.filter_block(&signal[0], &output_fir[0], signal.size());
+    });
+    printf("RollingBuffer convolution, %3u taps  %8.3f ns/sample\n", static_cast<unsigned>(TAPS), ns_naive);
+    printf("FIRFilter<%3u>::filter_block         %8.3f ns/sample (%.2fx)\n", static_cast<unsigned>(TAPS), ns_fir, ns_naive/ns_fir);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_naive[ii], output_fir[ii]);
+    }
+}
+
+template <size_t TAPS>
+void benchmark_fir_fft()
+{
+    std::vector<float> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal[ii] = sinf(0.01F*static_cast<float>(ii)) + 0.1F*sinf(1.3F*static_cast<float>(ii));
+    }
+    static FIRFilter<TAPS> filter;
+    filter.init_lowpass(10.0F, 0.001F);
+    static FIRFilterFFT<TAPS> filter_fft(filter.get_coefficients());
+
+    std::vector<float> output_fir(signal.size());
+    const double ns_fir = nanoseconds_per_sample([&]() {
+        filter.filter_block(&signal[0], &output_fir[0], signal.size());
+    });
+    std::vector<float> output_fft(signal.size());
+    const double ns_fft = nanoseconds_per_sample([&]() {
+        filter_fft.filter_block(&signal[0], &output_fft[0], signal.size());
+    });
+    printf("FIRFilter<%4u>::filter_block        %8.3f ns/sample\n", static_cast<unsigned>(TAPS), ns_fir);
+    printf("FIRFilterFFT<%4u>::filter_block     %8.3f ns/sample (%.2fx)\n", static_cast<unsigned>(TAPS), ns_fft, ns_fir/ns_fft);
+
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_fir[ii], output_fft[ii]);
+    }
+}
+
+template <size_t TAPS, size_t RATIO>
+void benchmark_fir_decimator()
+{
+    std::vector<float> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        signal[ii] = sinf(0.01F*static_cast<float>(ii)) + 0.1F*sinf(1.3F*static_cast<float>(ii));
+    }
+    // 32kHz input, anti-alias filter for 32kHz/RATIO output
+    constexpr float LOOPTIME = 1.0F/32000.0F;
+    constexpr float CUTOFF = 0.4F*16000.0F/static_cast<float>(RATIO);
+    FIRFilter<TAPS> filter;
+    filter.init_lowpass(CUTOFF, LOOPTIME);
+    FIRDecimator<TAPS, RATIO> decimator(filter.get_coefficients());
+
+    std::vector<float> output_fir(signal.size()/RATIO);
+    const double ns_fir = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            const float output = filter.filter(signal[ii]);
+            if (ii % RATIO == RATIO - 1) {
+                output_fir[ii/RATIO] = output;
+            }
+        }
+    });
+    std::vector<float> output_decimator(signal.size()/RATIO);
+    const double ns_decimator = nanoseconds_per_sample([&]() {
+        decimator.filter_block(&signal[0], &output_decimator[0], signal.size());
+    });
+    printf("FIRFilter<%3u>, keep 1 in %u          %8.3f ns/input sample\n", static_cast<unsigned>(TAPS), static_cast<unsigned>(RATIO), ns_fir);
+    printf("FIRDecimator<%3u, %u>::filter_block  %8.3f ns/input sample (%.2fx)\n", static_cast<unsigned>(TAPS), static_cast<unsigned>(RATIO), ns_decimator, ns_fir/ns_decimator);
+
+    for (size_t ii = 0; ii < output_fir.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_fir[ii], output_decimator[ii]);
+    }
+}
+} // end namespace
+
+void test_benchmark_fir_filter()
+{
+    benchmark_fir<16>();
+    benchmark_fir<64>();
+    benchmark_fir<128>();
+}
+
+void test_benchmark_fir_filter_fft()
+{
+    benchmark_fir_fft<64>();
+    benchmark_fir_fft<128>();
+    benchmark_fir_fft<512>();
+    benchmark_fir_fft<1024>();
+}
+
+void test_benchmark_fir_decimator()
+{
+    benchmark_fir_decimator<32, 4>();
+    benchmark_fir_decimator<64, 8>();
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_fir_filter);
+    RUN_TEST(test_benchmark_fir_filter_fft);
+    RUN_TEST(test_benchmark_fir_decimator);
+
+    UNITY_END();
+}
@@ -0,0 +1,103 @@
+#include "filters_fixed_point.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 20;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+template <typename Sample>
+std::vector<Sample> make_signal()
+{
+    std::vector<Sample> signal(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        const float t = static_cast<float>(ii)*0.000125F; // 8kHz
+        signal[ii] = FixedPoint<Sample>::from_float(0.5F*sinf(2.0F*3.14159265F*37.0F*t) + 0.2F*sinf(2.0F*3.14159265F*1200.0F*t));
+    }
+    return signal;
+}
+
+template <typename FILTER, typename Sample>
+double benchmark(FILTER& filter, const std::vector<Sample>& input, std::vector<Sample>& output)
+{
+    return nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < input.size(); ++ii) {
+            output[ii] = filter.filter(input[ii]);
+        }
+    });
+}
+} // end namespace
+
+/*!
+Throughput on the native target, which has hardware floating point, so this shows the relative cost of the fixed point arithmetic,
+not the speedup on a target without a floating point unit, where software float emulation typically costs 20 to 50 cycles per operation.
+*/
+void test_benchmark_fixed_point()
+{
+    const std::vector<float> signal_float = [] {
+        std::vector<float> signal(SAMPLE_COUNT);
+        const std::vector<int16_t> signal_q15 = make_signal<int16_t>();
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            signal[ii] = FixedPoint<int16_t>::to_float(signal_q15[ii]);
+        }
+        return signal;
+    }();
+    const std::vector<int16_t> signal_q15 = make_signal<int16_t>();
+    const std::vector<int32_t> signal_q31 = make_signal<int32_t>();
+    std::vector<float> output_float(SAMPLE_COUNT);
+    std::vector<int16_t> output_q15(SAMPLE_COUNT);
+    std::vector<int32_t> output_q31(SAMPLE_COUNT);
+
+    BiquadFilter biquad;
+    biquad.init_lowpass(100.0F, 0.000125F, 0.7071F);
+    BiquadFilterQ15 biquad_q15;
+    biquad_q15.init_lowpass(100.0F, 0.000125F, 0.7071F);
+    BiquadFilterQ31 biquad_q31;
+    biquad_q31.init_lowpass(100.0F, 0.000125F, 0.7071F);
+    printf("BiquadFilter::filter              %8.3f ns/sample\n", benchmark(biquad, signal_float, output_float));
+    printf("BiquadFilterQ15::filter           %8.3f ns/sample\n", benchmark(biquad_q15, signal_q15, output_q15));
+    printf("BiquadFilterQ31::filter           %8.3f ns/sample\n", benchmark(biquad_q31, signal_q31, output_q31));
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(5.0F/32768.0F, output_float[ii], FixedPoint<int16_t>::to_float(output_q15[ii]));
+    }
+
+    PowerTransferFilter3 pt3(100.0F, 0.000125F);
+    PowerTransferFilter3Q15 pt3_q15(100.0F, 0.000125F);
+    PowerTransferFilter3Q31 pt3_q31(100.0F, 0.000125F);
+    printf("PowerTransferFilter3::filter      %8.3f ns/sample\n", benchmark(pt3, signal_float, output_float));
+    printf("PowerTransferFilter3Q15::filter   %8.3f ns/sample\n", benchmark(pt3_q15, signal_q15, output_q15));
+    printf("PowerTransferFilter3Q31::filter   %8.3f ns/sample\n", benchmark(pt3_q31, signal_q31, output_q31));
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1.0F/32768.0F, output_float[ii], FixedPoint<int16_t>::to_float(output_q15[ii]));
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_fixed_point);
+
+    UNITY_END();
+}
@@ -0,0 +1,165 @@
+#include "filters.h"
+#include "rolling_buffer.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 64; // about 4 million samples, so the drift of the plain sum is visible
+constexpr size_t N = 32;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+//! error of `output` from the mean of the last N samples of `input`
+float error_from_true_mean(const std::vector<float>& input, float output)
+{
+    double sum = 0.0;
+    for (size_t ii = SAMPLE_COUNT - N; ii < SAMPLE_COUNT; ++ii) {
+        sum += static_cast<double>(input[ii]);
+    }
+    return std::fabs(output - static_cast<float>(sum/static_cast<double>(N)));
+}
+} // end namespace
+
+void test_benchmark_moving_average()
+{
+    std::vector<float> input(SAMPLE_COUNT);
+    std::vector<int16_t> input_int16(SAMPLE_COUNT);
+    uint32_t seed = 1;
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        input_int16[ii] = static_cast<int16_t>(seed >> 16U);
+        input[ii] = 1000.0F + static_cast<float>(input_int16[ii])*(1.0F/32768.0F);
+    }
+
+    static FilterMovingAverage<N> plain;
+    float output_plain = 0.0F;
+    const double ns_plain = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_plain = plain.filter(input[ii]);
+        }
+    });
+    static FilterMovingAverage<N, SumNeumaier<float>> compensated;
+    float output_compensated = 0.0F;
+    const double ns_compensated = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_compensated = compensated.filter(input[ii]);
+        }
+    });
+
+    static RollingBufferWithSum<int32_t, N> rb_plain;
+    const double ns_rb_plain = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            rb_plain.push_back(input_int16[ii]);
+        }
+    });
+    static RollingBufferWithSum<int16_t, N, SumInteger<int16_t>> rb_integer;
+    const double ns_rb_integer = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            rb_integer.push_back(input_int16[ii]);
+        }
+    });
+
+    const float error_plain = error_from_true_mean(input, output_plain);
+    const float error_compensated = error_from_true_mean(input, output_compensated);
+    printf("N=%u, %u samples\n", static_cast<unsigned>(N), static_cast<unsigned>(SAMPLE_COUNT)*static_cast<unsigned>(REPEATS));
+    printf("FilterMovingAverage SumPlain             %6.2f ns/sample, error %.2e\n", ns_plain, static_cast<double>(error_plain));
+    printf("FilterMovingAverage SumNeumaier          %6.2f ns/sample, error %.2e\n", ns_compensated, static_cast<double>(error_compensated));
+    printf("RollingBufferWithSum<int32_t>            %6.2f ns/sample\n", ns_rb_plain);
+    printf("RollingBufferWithSum<int16_t> SumInteger %6.2f ns/sample\n", ns_rb_integer);
+
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4F, error_compensated);
+    TEST_ASSERT_TRUE(rb_plain.sum() == rb_integer.sum());
+    TEST_ASSERT_TRUE(rb_integer.sum() == rb_integer.recalculate_sum());
+}
+
+namespace {
+using outputs3_t = std::array<float, 3>;
+
+/*!
+Returns `fn` through a volatile function pointer, so it is not inlined into the benchmark loop.
+The filter state is then loaded and stored on each call, as when a filter is called once per control loop,
+rather than being held in registers across the whole loop.
+*/
+outputs3_t (*opaque(outputs3_t (*fn)(float)))(float)
+{
+    outputs3_t (* volatile pointer)(float) = fn;
+    return pointer;
+}
+
+template <size_t MAX_N>
+void benchmark_multi_moving_average()
+{
+    std::vector<float> input(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        input[ii] = sinf(0.01F*static_cast<float>(ii));
+    }
+
+    static FilterMovingAverage<4> filter4;
+    static FilterMovingAverage<16> filter16;
+    static FilterMovingAverage<MAX_N> filter_max;
+    auto* separate = opaque([](float value) { return outputs3_t {{ filter4.filter(value), filter16.filter(value), filter_max.filter(value) }}; });
+    std::vector<outputs3_t> output_separate(SAMPLE_COUNT);
+    const double ns_separate = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_separate[ii] = separate(input[ii]);
+        }
+    });
+
+    static FilterMultiMovingAverage<4, 16, MAX_N> multi;
+    auto* combined = opaque([](float value) { return multi.filter(value); });
+    std::vector<outputs3_t> output_multi(SAMPLE_COUNT);
+    const double ns_multi = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_multi[ii] = combined(input[ii]);
+        }
+    });
+
+    printf("windows 4, 16 and %u, called once per sample\n", static_cast<unsigned>(MAX_N));
+    printf("3 x FilterMovingAverage                %6.2f ns/sample, %4u bytes\n", ns_separate,
+        static_cast<unsigned>(sizeof(filter4) + sizeof(filter16) + sizeof(filter_max)));
+    printf("FilterMultiMovingAverage<4, 16, %u>    %6.2f ns/sample, %4u bytes (%.2fx)\n", static_cast<unsigned>(MAX_N), ns_multi,
+        static_cast<unsigned>(sizeof(multi)), ns_separate/ns_multi);
+
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_separate[ii][0], output_multi[ii][0]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output_separate[ii][2], output_multi[ii][2]);
+    }
+}
+} // end namespace
+
+void test_benchmark_multi_moving_average()
+{
+    benchmark_multi_moving_average<64>();
+    // the history is not rounded up to a power of two
+    benchmark_multi_moving_average<65>();
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_moving_average);
+    RUN_TEST(test_benchmark_multi_moving_average);
+
+    UNITY_END();
+}
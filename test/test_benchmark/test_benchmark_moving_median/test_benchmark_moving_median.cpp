@@ -0,0 +1,108 @@
+#include "filter_moving_median.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 13U;
+constexpr int REPEATS = 5;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+//! the naive approach: keep the window in arrival order, and copy and sort it for each sample
+template <size_t N>
+class FilterSortedMedian {
+public:
+    float filter(float input) {
+        _window[_index] = input;
+        _index = (_index + 1 == N) ? 0 : _index + 1;
+        _count = std::min(_count + 1, N);
+        std::copy(_window.begin(), _window.begin() + static_cast<std::ptrdiff_t>(_count), _sorted.begin());
+        std::sort(_sorted.begin(), _sorted.begin() + static_cast<std::ptrdiff_t>(_count));
+        return (_count % 2 == 1) ? _sorted[_count/2] : (_sorted[_count/2 - 1] + _sorted[_count/2])*0.5F;
+    }
+private:
+    std::array<float, N> _window {};
+    std::array<float, N> _sorted {};
+    size_t _index {0};
+    size_t _count {0};
+};
+
+template <size_t N>
+void benchmark(const std::vector<float>& input)
+{
+    std::vector<float> output_sorted(SAMPLE_COUNT);
+    std::vector<float> output_median(SAMPLE_COUNT);
+    std::vector<float> output_hampel(SAMPLE_COUNT);
+
+    static FilterSortedMedian<N> sorted;
+    const double ns_sorted = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_sorted[ii] = sorted.filter(input[ii]);
+        }
+    });
+    static FilterMovingMedian<N> median;
+    const double ns_median = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_median[ii] = median.filter(input[ii]);
+        }
+    });
+    static FilterHampel<N> hampel;
+    const double ns_hampel = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_hampel[ii] = hampel.filter(input[ii]);
+        }
+    });
+
+    printf("N=%3u sort %8.1f ns/sample, FilterMovingMedian %6.1f ns/sample (%5.1fx), FilterHampel %6.1f ns/sample\n",
+        static_cast<unsigned>(N), ns_sorted, ns_median, ns_sorted/ns_median, ns_hampel);
+
+    // every repeat continues from the previous one, so the windows are the same
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(output_sorted[ii], output_median[ii]);
+    }
+}
+} // end namespace
+
+void test_benchmark_moving_median()
+{
+    // noisy signal with occasional spikes
+    std::vector<float> input(SAMPLE_COUNT);
+    uint32_t seed = 1;
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        const float noise = 0.1F*(static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U) - 0.5F);
+        input[ii] = sinf(0.01F*static_cast<float>(ii)) + noise + ((ii % 97 == 0) ? 10.0F : 0.0F);
+    }
+    benchmark<15>(input);
+    benchmark<63>(input);
+    benchmark<255>(input);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_moving_median);
+
+    UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include "filter_templates.h"
+#include "filters.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+#include <xyz_type.h>
+
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t SAMPLE_COUNT = 1U << 16U;
+constexpr int REPEATS = 20;
+
+template <typename F>
+double nanoseconds_per_sample(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(SAMPLE_COUNT));
+}
+
+template <typename FILTER, typename T>
+double time_filter(FILTER& filter, const std::vector<T>& input, std::vector<T>& output)
+{
+    return nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < input.size(); ++ii) {
+            output[ii] = filter.filter(input[ii]);
+        }
+    });
+}
+
+template <typename FILTER, typename T>
+double time_filter_block(FILTER& filter, const std::vector<T>& input, std::vector<T>& output)
+{
+    return nanoseconds_per_sample([&]() { filter.filter_block(&input[0], &output[0], input.size()); });
+}
+} // end namespace
+
+void test_benchmark_power_transfer_n_float()
+{
+    std::vector<float> input(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        input[ii] = sinf(0.01F*static_cast<float>(ii));
+    }
+    std::vector<float> output_hand(SAMPLE_COUNT);
+    std::vector<float> output_n(SAMPLE_COUNT);
+    std::vector<float> output_block(SAMPLE_COUNT);
+
+    PowerTransferFilter3T<float> pt3(0.1F);
+    PowerTransferFilterN<3> pt3n(0.1F);
+    PowerTransferFilterN<3> pt3n_block(0.1F);
+    const double ns_hand = time_filter(pt3, input, output_hand);
+    const double ns_n = time_filter(pt3n, input, output_n);
+    const double ns_block = time_filter_block(pt3n_block, input, output_block);
+    PowerTransferFilterN<8> pt8n(0.1F);
+    const double ns_8 = time_filter(pt8n, input, output_n);
+    PowerTransferFilterN<8> pt8n_block(0.1F);
+    const double ns_8_block = time_filter_block(pt8n_block, input, output_n);
+
+    printf("PowerTransferFilter3T<float>           %8.3f ns/sample\n", ns_hand);
+    printf("PowerTransferFilterN<3>                %8.3f ns/sample (%.2fx)\n", ns_n, ns_hand/ns_n);
+    printf("PowerTransferFilterN<3> filter_block   %8.3f ns/sample (%.2fx)\n", ns_block, ns_hand/ns_block);
+    printf("PowerTransferFilterN<8>                %8.3f ns/sample\n", ns_8);
+    printf("PowerTransferFilterN<8> filter_block   %8.3f ns/sample\n", ns_8_block);
+
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(output_hand[ii], output_block[ii]);
+    }
+}
+
+void test_benchmark_power_transfer_n_xyz()
+{
+    std::vector<xyz_t> input(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        const float t = static_cast<float>(ii);
+        input[ii] = xyz_t { sinf(0.01F*t), cosf(0.03F*t), 0.5F };
+    }
+    std::vector<xyz_t> output_hand(SAMPLE_COUNT);
+    std::vector<xyz_t> output_n(SAMPLE_COUNT);
+
+    PowerTransferFilter3T<xyz_t> pt3(0.1F);
+    PowerTransferFilterN<3, xyz_t> pt3n(0.1F);
+    PowerTransferFilterN<3, xyz_t> pt3n_block(0.1F);
+    const double ns_hand = time_filter(pt3, input, output_hand);
+    const double ns_n = time_filter(pt3n, input, output_n);
+    const double ns_block = time_filter_block(pt3n_block, input, output_n);
+
+    printf("PowerTransferFilter3T<xyz_t>           %8.3f ns/sample\n", ns_hand);
+    printf("PowerTransferFilterN<3, xyz_t>         %8.3f ns/sample (%.2fx)\n", ns_n, ns_hand/ns_n);
+    printf("PowerTransferFilterN<3, xyz_t> block   %8.3f ns/sample (%.2fx)\n", ns_block, ns_hand/ns_block);
+
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(output_hand[ii].y, output_n[ii].y);
+    }
+}
+namespace {
+//! Hides `fn` from the optimizer, so each sample is a call and the filter state is loaded and stored on every sample, as in a control loop.
+float (*opaque(float (*fn)(float, float)))(float, float)
+{
+    float (* volatile pointer)(float, float) = fn;
+    return pointer;
+}
+} // end namespace
+
+void test_benchmark_power_transfer_variable_dt()
+{
+    std::vector<float> input(SAMPLE_COUNT);
+    std::vector<float> dts(SAMPLE_COUNT);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        const float t = static_cast<float>(ii);
+        input[ii] = sinf(0.01F*t);
+        dts[ii] = 0.001F*(1.0F + 0.1F*sinf(1.3F*t)); // 10% loop time jitter
+    }
+    static float cutoff_frequency_hz {};
+    cutoff_frequency_hz = 100.0F; // set at run time, as from a configuration
+    static PowerTransferFilter3 set(cutoff_frequency_hz, 0.001F);
+    static PowerTransferFilter3 variable(cutoff_frequency_hz, 0.001F);
+
+    auto* set_and_filter = opaque([](float value, float dt) { set.set_cutoff_frequency(cutoff_frequency_hz, dt); return set.filter(value); });
+    std::vector<float> output_set(SAMPLE_COUNT);
+    const double ns_set = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_set[ii] = set_and_filter(input[ii], dts[ii]);
+        }
+    });
+    auto* filter_variable_dt = opaque([](float value, float dt) { return variable.filter_variable_dt(value, dt); });
+    std::vector<float> output_variable(SAMPLE_COUNT);
+    const double ns_variable = nanoseconds_per_sample([&]() {
+        for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+            output_variable[ii] = filter_variable_dt(input[ii], dts[ii]);
+        }
+    });
+
+    printf("PowerTransferFilter3 set_cutoff_frequency + filter  %8.3f ns/sample\n", ns_set);
+    printf("PowerTransferFilter3 filter_variable_dt             %8.3f ns/sample (%.2fx)\n", ns_variable, ns_set/ns_variable);
+    for (size_t ii = 0; ii < SAMPLE_COUNT; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(output_set[ii], output_variable[ii]);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_power_transfer_n_float);
+    RUN_TEST(test_benchmark_power_transfer_n_xyz);
+    RUN_TEST(test_benchmark_power_transfer_variable_dt);
+
+    UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include "filters.h"
+#include "rpm_notch_filter_bank.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+#include <xyz_type.h>
+
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr size_t LOOP_COUNT = 1U << 14U;
+constexpr int REPEATS = 10;
+constexpr size_t MOTORS = 4;
+constexpr size_t HARMONICS = 3;
+constexpr size_t AXES = 3;
+constexpr float LOOPTIME = 0.000125F; // 8kHz
+constexpr float Q = 3.0F;
+constexpr float MIN_FREQUENCY = 100.0F;
+constexpr float FADE_RANGE = 50.0F;
+
+template <typename F>
+double nanoseconds_per_loop(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < REPEATS; ++ii) {
+        fn();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/(static_cast<double>(REPEATS)*static_cast<double>(LOOP_COUNT));
+}
+
+float motor_frequency(size_t loop, size_t motor)
+{
+    return 200.0F + 100.0F*static_cast<float>(motor) + 50.0F*sinf(0.001F*static_cast<float>(loop));
+}
+
+//! the existing approach: one BiquadFilter per motor, harmonic and axis, each updated with its own trig
+struct notch_filters_t {
+    std::array<BiquadFilter, MOTORS*HARMONICS*AXES> notches {};
+    notch_filters_t() {
+        for (auto& notch : notches) {
+            notch.init_notch(MIN_FREQUENCY, LOOPTIME, Q);
+        }
+    }
+    void set_motor_frequencies(const std::array<float, MOTORS>& frequencies) {
+        for (size_t motor = 0; motor < MOTORS; ++motor) {
+            const float fade = std::clamp((frequencies[motor] - MIN_FREQUENCY)/FADE_RANGE, 0.0F, 1.0F);
+            const float frequency = std::max(frequencies[motor], MIN_FREQUENCY);
+            for (size_t harmonic = 0; harmonic < HARMONICS; ++harmonic) {
+                for (size_t axis = 0; axis < AXES; ++axis) {
+                    notches[(motor*HARMONICS + harmonic)*AXES + axis].set_notch_frequency_weighted(frequency*static_cast<float>(harmonic + 1), fade);
+                }
+            }
+        }
+    }
+    xyz_t filter(const xyz_t& input) {
+        xyz_t output = input;
+        for (size_t ii = 0; ii < MOTORS*HARMONICS; ++ii) {
+            output.x = notches[ii*AXES].filter_weighted(output.x);
+            output.y = notches[ii*AXES + 1].filter_weighted(output.y);
+            output.z = notches[ii*AXES + 2].filter_weighted(output.z);
+        }
+        return output;
+    }
+};
+} // end namespace
+
+void test_benchmark_rpm_notch()
+{
+    std::vector<xyz_t> gyro(LOOP_COUNT);
+    std::vector<std::array<float, MOTORS>> frequencies(LOOP_COUNT);
+    for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+        const float t = static_cast<float>(ii)*LOOPTIME;
+        gyro[ii] = xyz_t { sinf(2.0F*3.14159265F*230.0F*t), sinf(2.0F*3.14159265F*17.0F*t), sinf(2.0F*3.14159265F*640.0F*t) };
+        for (size_t motor = 0; motor < MOTORS; ++motor) {
+            frequencies[ii][motor] = motor_frequency(ii, motor);
+        }
+    }
+
+    static notch_filters_t filters;
+    std::vector<xyz_t> output_filters(LOOP_COUNT);
+    const double ns_update_filters = nanoseconds_per_loop([&]() {
+        for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+            filters.set_motor_frequencies(frequencies[ii]);
+        }
+    });
+    const double ns_filters = nanoseconds_per_loop([&]() {
+        for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+            filters.set_motor_frequencies(frequencies[ii]);
+            output_filters[ii] = filters.filter(gyro[ii]);
+        }
+    });
+
+    static RPMNotchFilterBank<xyz_t, MOTORS, HARMONICS> bank;
+    bank.init(LOOPTIME, Q, MIN_FREQUENCY, FADE_RANGE);
+    std::vector<xyz_t> output_bank(LOOP_COUNT);
+    const double ns_update_bank = nanoseconds_per_loop([&]() {
+        for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+            bank.set_motor_frequencies(frequencies[ii]);
+        }
+    });
+    bank.reset();
+    const double ns_bank = nanoseconds_per_loop([&]() {
+        for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+            bank.set_motor_frequencies(frequencies[ii]);
+            output_bank[ii] = bank.filter(gyro[ii]);
+        }
+    });
+
+    printf("%u motors x %u harmonics x %u axes\n", static_cast<unsigned>(MOTORS), static_cast<unsigned>(HARMONICS), static_cast<unsigned>(AXES));
+    printf("BiquadFilter x36 update            %8.2f ns/loop\n", ns_update_filters);
+    printf("RPMNotchFilterBank update          %8.2f ns/loop (%.2fx)\n", ns_update_bank, ns_update_filters/ns_update_bank);
+    printf("BiquadFilter x36 update + filter   %8.2f ns/loop\n", ns_filters);
+    printf("RPMNotchFilterBank update + filter %8.2f ns/loop (%.2fx)\n", ns_bank, ns_filters/ns_bank);
+
+    // the outputs of the final repeat agree, to within the accuracy of the recurrence and the trig approximation
+    for (size_t ii = 0; ii < LOOP_COUNT; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(2e-3F, output_filters[ii].x, output_bank[ii].x);
+        TEST_ASSERT_FLOAT_WITHIN(2e-3F, output_filters[ii].z, output_bank[ii].z);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_rpm_notch);
+
+    UNITY_END();
+}
@@ -0,0 +1,91 @@
+#include "filters.h"
+#include <chrono>
+#include <cstdio>
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr int UPDATE_COUNT = 1 << 20;
+
+template <typename F>
+double nanoseconds_per_update(F&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed/static_cast<double>(UPDATE_COUNT);
+}
+
+// sweep the notch across 80Hz to 580Hz, as dynamic notch tracking does
+float sweep_frequency(int index)
+{
+    return 80.0F + static_cast<float>(index & 1023)*(500.0F/1024.0F);
+}
+
+template <typename TRIG>
+double benchmark_notch(float& checksum)
+{
+    BiquadFilter filter; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_notch(200.0F, 0.000125F, 3.0F);
+    const double ns = nanoseconds_per_update([&]() {
+        for (int ii = 0; ii < UPDATE_COUNT; ++ii) {
+            filter.set_notch_frequency_weighted<TRIG>(sweep_frequency(ii), 1.0F);
+            checksum += filter.filter(1.0F);
+        }
+    });
+    return ns;
+}
+
+template <typename TRIG>
+double benchmark_lowpass(float& checksum)
+{
+    BiquadFilter filter; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_lowpass(200.0F, 0.000125F, 0.7071F);
+    const double ns = nanoseconds_per_update([&]() {
+        for (int ii = 0; ii < UPDATE_COUNT; ++ii) {
+            filter.set_low_pass_frequencyWeighted<TRIG>(sweep_frequency(ii), 1.0F);
+            checksum += filter.filter(1.0F);
+        }
+    });
+    return ns;
+}
+} // end namespace
+
+void test_benchmark_trig_policies()
+{
+    float checksum_libm = 0.0F;
+    float checksum_polynomial = 0.0F;
+    float checksum_lookup_table = 0.0F;
+    const double notch_libm = benchmark_notch<TrigLibm>(checksum_libm);
+    const double notch_polynomial = benchmark_notch<TrigPolynomial>(checksum_polynomial);
+    const double notch_lookup_table = benchmark_notch<TrigLookupTable>(checksum_lookup_table);
+    printf("set_notch_frequency_weighted<TrigLibm>           %6.3f ns/update\n", notch_libm);
+    printf("set_notch_frequency_weighted<TrigPolynomial>     %6.3f ns/update (%.2fx)\n", notch_polynomial, notch_libm/notch_polynomial);
+    printf("set_notch_frequency_weighted<TrigLookupTable>    %6.3f ns/update (%.2fx)\n", notch_lookup_table, notch_libm/notch_lookup_table);
+
+    const double lowpass_libm = benchmark_lowpass<TrigLibm>(checksum_libm);
+    const double lowpass_polynomial = benchmark_lowpass<TrigPolynomial>(checksum_polynomial);
+    const double lowpass_lookup_table = benchmark_lowpass<TrigLookupTable>(checksum_lookup_table);
+    printf("set_low_pass_frequencyWeighted<TrigLibm>         %6.3f ns/update\n", lowpass_libm);
+    printf("set_low_pass_frequencyWeighted<TrigPolynomial>   %6.3f ns/update (%.2fx)\n", lowpass_polynomial, lowpass_libm/lowpass_polynomial);
+    printf("set_low_pass_frequencyWeighted<TrigLookupTable>  %6.3f ns/update (%.2fx)\n", lowpass_lookup_table, lowpass_libm/lowpass_lookup_table);
+
+    TEST_ASSERT_FLOAT_WITHIN(checksum_libm*1e-3F, checksum_libm, checksum_polynomial);
+    TEST_ASSERT_FLOAT_WITHIN(checksum_libm*1e-3F, checksum_libm, checksum_lookup_table);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_trig_policies);
+
+    UNITY_END();
+}
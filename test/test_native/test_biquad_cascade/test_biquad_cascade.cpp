@@ -0,0 +1,123 @@
+#include "biquad_cascade.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+void test_biquad_cascade_passthrough()
+{
+    BiquadCascade<3> filter; // NOLINT(cppcoreguidelines-init-variables)
+    TEST_ASSERT_EQUAL(3, filter.stage_count());
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, filter.filter(1.0F));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0F, filter.filter(-1.0F));
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter_weighted(2.0F));
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, filter.filter_virtual(3.0F));
+}
+
+void test_biquad_cascade_matches_chained_biquads()
+{
+    BiquadCascade<3> cascade; // NOLINT(cppcoreguidelines-init-variables)
+    std::array<BiquadFilter, 3> filters {};
+    cascade.init_lowpass(0, 100.0F, 0.001F, 0.5412F);
+    filters[0].init_lowpass(100.0F, 0.001F, 0.5412F);
+    cascade.init_lowpass(1, 100.0F, 0.001F, 1.3066F);
+    filters[1].init_lowpass(100.0F, 0.001F, 1.3066F);
+    cascade.init_notch(2, 200.0F, 0.001F, 5.0F);
+    filters[2].init_notch(200.0F, 0.001F, 5.0F);
+
+    for (size_t ii = 0; ii < 100; ++ii) {
+        const float input = sinf(0.05F*static_cast<float>(ii)) + (ii == 10 ? 1.0F : 0.0F);
+        float expected = input;
+        for (auto& filter : filters) {
+            expected = filter.filter(expected);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected, cascade.filter(input));
+    }
+
+    cascade.set_weight(1, 0.5F);
+    filters[1].set_weight(0.5F);
+    cascade.set_weight(2, 0.25F);
+    filters[2].set_weight(0.25F);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, cascade.get_weight(1));
+    for (size_t ii = 0; ii < 100; ++ii) {
+        const float input = cosf(0.2F*static_cast<float>(ii));
+        float expected = input;
+        for (auto& filter : filters) {
+            expected = filter.filter_weighted(expected);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected, cascade.filter_weighted(input));
+    }
+}
+
+void test_biquad_cascade_block()
+{
+    BiquadCascade<2> filter; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadCascade<2> reference; // NOLINT(cppcoreguidelines-init-variables)
+    for (size_t ii = 0; ii < 2; ++ii) {
+        filter.init_lowpass(ii, 80.0F, 0.001F, 0.7071F);
+        reference.init_lowpass(ii, 80.0F, 0.001F, 0.7071F);
+    }
+    filter.set_weight(1, 0.75F);
+    reference.set_weight(1, 0.75F);
+
+    std::array<float, 32> input {};
+    std::array<float, 32> output {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = static_cast<float>(ii % 7) - 3.0F;
+    }
+    filter.filter_block(&input[0], &output[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter(input[ii]), output[ii]);
+    }
+    filter.filter_weighted_block(&input[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter_weighted(static_cast<float>(ii % 7) - 3.0F), input[ii]);
+    }
+
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[0].s1);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[1].s2);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[1].y1);
+}
+
+void test_biquad_cascade_parameters_from_biquad()
+{
+    BiquadFilter biquad; // NOLINT(cppcoreguidelines-init-variables)
+    biquad.init_notch(150.0F, 0.001F, 2.0F);
+    biquad.set_weight(0.5F);
+    BiquadCascade<2> cascade; // NOLINT(cppcoreguidelines-init-variables)
+    cascade.set_parameters(1, biquad);
+
+    const biquad_coefficients_t expected = biquad.get_parameters();
+    const biquad_coefficients_t& actual = cascade.get_parameters(1);
+    TEST_ASSERT_EQUAL_FLOAT(expected.a1, actual.a1);
+    TEST_ASSERT_EQUAL_FLOAT(expected.a2, actual.a2);
+    TEST_ASSERT_EQUAL_FLOAT(expected.b0, actual.b0);
+    TEST_ASSERT_EQUAL_FLOAT(expected.b1, actual.b1);
+    TEST_ASSERT_EQUAL_FLOAT(expected.b2, actual.b2);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, cascade.get_weight(1));
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, cascade.get_parameters(0).b0);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, cascade.get_weight(0));
+
+    for (size_t ii = 0; ii < 50; ++ii) {
+        const float input = sinf(0.3F*static_cast<float>(ii));
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, biquad.filter_weighted(input), cascade.filter_weighted(input));
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_biquad_cascade_passthrough);
+    RUN_TEST(test_biquad_cascade_matches_chained_biquads);
+    RUN_TEST(test_biquad_cascade_block);
+    RUN_TEST(test_biquad_cascade_parameters_from_biquad);
+
+    UNITY_END();
+}
@@ -0,0 +1,116 @@
+#include "biquad_filter_bank.h"
+#include "filters.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+template <size_t N>
+static void configure(BiquadFilterBank<N>& bank, std::array<BiquadFilter, N>& filters)
+{
+    for (size_t ii = 0; ii < N; ++ii) {
+        const float frequency = 20.0F + 10.0F*static_cast<float>(ii);
+        if (ii % 2 == 0) {
+            bank.init_lowpass(ii, frequency, 0.001F, 0.7071F);
+            filters[ii].init_lowpass(frequency, 0.001F, 0.7071F);
+        } else {
+            bank.init_notch(ii, frequency, 0.001F, 3.0F);
+            filters[ii].init_notch(frequency, 0.001F, 3.0F);
+        }
+    }
+}
+
+template <size_t N>
+static void check_against_biquad_filters()
+{
+    BiquadFilterBank<N> bank;
+    std::array<BiquadFilter, N> filters {};
+    configure(bank, filters);
+
+    std::array<float, N> input {};
+    std::array<float, N> output {};
+    for (size_t step = 0; step < 50; ++step) {
+        for (size_t ii = 0; ii < N; ++ii) {
+            input[ii] = sinf(0.1F*static_cast<float>(step*(ii + 1))) + (step == 5 ? 1.0F : 0.0F);
+        }
+        bank.filter(input, output);
+        for (size_t ii = 0; ii < N; ++ii) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5F, filters[ii].filter(input[ii]), output[ii]);
+        }
+    }
+
+    // dynamic notch update with weight
+    for (size_t ii = 0; ii < N; ++ii) {
+        bank.set_q(ii, 3.0F);
+        filters[ii].set_q(3.0F);
+        bank.set_notch_frequency_weighted(ii, 120.0F, 0.5F);
+        filters[ii].set_notch_frequency_weighted(120.0F, 0.5F);
+        TEST_ASSERT_EQUAL_FLOAT(0.5F, bank.get_weight(ii));
+    }
+    for (size_t step = 0; step < 20; ++step) {
+        for (size_t ii = 0; ii < N; ++ii) {
+            input[ii] = cosf(0.3F*static_cast<float>(step + ii));
+        }
+        bank.filter_weighted(input, output);
+        for (size_t ii = 0; ii < N; ++ii) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5F, filters[ii].filter_weighted(input[ii]), output[ii]);
+        }
+    }
+}
+
+void test_biquad_filter_bank_passthrough()
+{
+    BiquadFilterBank<5> bank;
+    std::array<float, 5> input {{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F }};
+    std::array<float, 5> output {};
+    bank.filter(input, output);
+    for (size_t ii = 0; ii < 5; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(input[ii], output[ii]);
+    }
+    // in place
+    bank.filter(&input[0], &input[0]);
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, input[4]);
+}
+
+void test_biquad_filter_bank_matches_biquad_filter()
+{
+    check_against_biquad_filters<1>();
+    check_against_biquad_filters<3>();
+    check_against_biquad_filters<7>(); // exercises the SIMD remainder
+    check_against_biquad_filters<12>();
+    check_against_biquad_filters<36>();
+}
+
+void test_biquad_filter_bank_reset()
+{
+    BiquadFilterBank<4> bank;
+    for (size_t ii = 0; ii < 4; ++ii) {
+        bank.init_lowpass(ii, 100.0F, 0.001F, 0.7071F);
+    }
+    std::array<float, 4> input {{ 1.0F, 1.0F, 1.0F, 1.0F }};
+    std::array<float, 4> first {};
+    std::array<float, 4> output {};
+    bank.filter(input, first);
+    bank.filter(input, output);
+    bank.reset();
+    bank.filter(input, output);
+    for (size_t ii = 0; ii < 4; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(first[ii], output[ii]);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_biquad_filter_bank_passthrough);
+    RUN_TEST(test_biquad_filter_bank_matches_biquad_filter);
+    RUN_TEST(test_biquad_filter_bank_reset);
+
+    UNITY_END();
+}
@@ -0,0 +1,130 @@
+#include "cic_decimator.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+void test_cic_decimator_single_stage_is_moving_average()
+{
+    CICDecimator<1, 8> cic;
+    FilterMovingAverage<8> moving_average;
+    std::array<int16_t, 100> input {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = static_cast<int16_t>((ii*7919) % 2001) - 1000;
+    }
+    std::array<float, 13> output {};
+    TEST_ASSERT_EQUAL(12, cic.filter_block(&input[0], &output[0], input.size()));
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        const float expected = moving_average.filter(static_cast<float>(input[ii]));
+        if (ii % 8 == 7) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-3F, expected, output[ii/8]);
+        }
+    }
+}
+
+void test_cic_decimator_matches_cascaded_moving_averages()
+{
+    constexpr size_t RATIO = 4;
+    CICDecimator<3, RATIO> cic;
+    TEST_ASSERT_EQUAL_FLOAT(4.5F, cic.latency());
+    std::array<FilterMovingAverage<RATIO>, 3> moving_averages {};
+    // FilterMovingAverage averages over the samples so far while filling, so prime with zeros
+    for (auto& moving_average : moving_averages) {
+        for (size_t ii = 0; ii < RATIO; ++ii) {
+            moving_average.filter(0.0F);
+        }
+    }
+    float output = 0.0F;
+    size_t output_count = 0;
+    for (int32_t ii = 0; ii < 200; ++ii) {
+        const int32_t input = (ii*ii*31) % 100000 - 50000;
+        float expected = static_cast<float>(input);
+        for (auto& moving_average : moving_averages) {
+            expected = moving_average.filter(expected);
+        }
+        if (cic.filter(input, output)) {
+            ++output_count;
+            TEST_ASSERT_FLOAT_WITHIN(0.05F, expected, output);
+        }
+    }
+    TEST_ASSERT_EQUAL(50, output_count);
+}
+
+void test_cic_decimator_full_scale()
+{
+    // 16 bit input, 5 stages of ratio 64 needs 46 bit registers
+    CICDecimator<5, 64> cic;
+    std::array<int16_t, 64*8> input {};
+    input.fill(INT16_MIN);
+    std::array<float, 8> output {};
+    TEST_ASSERT_EQUAL(8, cic.filter_block(&input[0], &output[0], input.size()));
+    TEST_ASSERT_EQUAL_FLOAT(-32768.0F, output[7]);
+    input.fill(INT16_MAX);
+    for (size_t ii = 0; ii < 1000; ++ii) {
+        cic.filter_block(&input[0], &output[0], input.size());
+    }
+    TEST_ASSERT_EQUAL_FLOAT(32767.0F, output[7]);
+
+    cic.reset();
+    TEST_ASSERT_EQUAL(8, cic.filter_block(&input[0], &output[0], input.size()));
+    TEST_ASSERT_EQUAL_FLOAT(32767.0F, output[7]);
+}
+
+namespace {
+template <size_t N>
+float compensated_response(const std::array<float, N>& coefficients, float frequency)
+{
+    float re = 0.0F;
+    float im = 0.0F;
+    for (size_t ii = 0; ii < N; ++ii) {
+        re += coefficients[ii]*cosf(2.0F*3.14159265F*frequency*static_cast<float>(ii));
+        im += coefficients[ii]*sinf(2.0F*3.14159265F*frequency*static_cast<float>(ii));
+    }
+    return sqrtf(re*re + im*im)*CICDecimator<3, 16, N>::magnitude_response(frequency);
+}
+} // end namespace
+
+void test_cic_decimator_compensation()
+{
+    CICDecimator<3, 16, 15> cic;
+    const auto& coefficients = cic.get_compensation_coefficients();
+    float sum = 0.0F;
+    for (size_t ii = 0; ii < coefficients.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, coefficients[ii], coefficients[coefficients.size() - 1 - ii]);
+        sum += coefficients[ii];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 1.0F, sum);
+
+    // the CIC alone droops by about 1dB at 0.15 of the output sample rate, the compensated response is within 0.15dB
+    TEST_ASSERT_TRUE((CICDecimator<3, 16, 15>::magnitude_response(0.15F) < 0.9F));
+    TEST_ASSERT_FLOAT_WITHIN(0.02F, 1.0F, compensated_response(coefficients, 0.15F));
+    // with a wider passband, the compensated response is flat to 0.2 of the output sample rate
+    cic.init_compensation(0.7F);
+    TEST_ASSERT_TRUE((CICDecimator<3, 16, 15>::magnitude_response(0.2F) < 0.85F));
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 1.0F, compensated_response(coefficients, 0.2F));
+    TEST_ASSERT_EQUAL_FLOAT(3.0F*15.0F*0.5F + 7.0F*16.0F, cic.latency());
+
+    // DC gain is unity
+    std::array<int32_t, 16*32> input {};
+    input.fill(1000);
+    std::array<float, 32> output {};
+    cic.filter_block(&input[0], &output[0], input.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 1000.0F, output[31]);
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cic_decimator_single_stage_is_moving_average);
+    RUN_TEST(test_cic_decimator_matches_cascaded_moving_averages);
+    RUN_TEST(test_cic_decimator_full_scale);
+    RUN_TEST(test_cic_decimator_compensation);
+
+    UNITY_END();
+}
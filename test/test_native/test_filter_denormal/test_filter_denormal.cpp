@@ -0,0 +1,147 @@
+#include "filter_templates.h"
+#include "filters.h"
+#include <unity.h>
+#include <xyz_type.h>
+
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+// volatile, so the products are calculated at run time, rather than by the compiler
+float multiply(float a, float b)
+{
+    volatile float x = a;
+    volatile float y = b;
+    return x*y;
+}
+} // end namespace
+
+void test_denormal_guard()
+{
+    // 1e-30*1e-10 is subnormal
+    TEST_ASSERT_TRUE(multiply(1e-30F, 1e-10F) != 0.0F);
+    {
+        const DenormalGuard guard;
+        if (DenormalGuard::is_supported()) {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, multiply(1e-30F, 1e-10F));
+        }
+        // normal arithmetic is unaffected
+        TEST_ASSERT_EQUAL_FLOAT(1e-20F, multiply(1e-10F, 1e-10F));
+    }
+    // previous mode is restored
+    TEST_ASSERT_TRUE(multiply(1e-30F, 1e-10F) != 0.0F);
+}
+
+void test_denormal_guard_nested()
+{
+    {
+        const DenormalGuard outer;
+        {
+            const DenormalGuard inner;
+        }
+        // inner guard restores flush-to-zero mode set by outer guard
+        if (DenormalGuard::is_supported()) {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, multiply(1e-30F, 1e-10F));
+        }
+    }
+    TEST_ASSERT_TRUE(multiply(1e-30F, 1e-10F) != 0.0F);
+}
+
+void test_filter_denormal_flush()
+{
+    float value = 1e-35F;
+    FilterDenormal::flush(value);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, value);
+    value = -1e-35F;
+    FilterDenormal::flush(value);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, value);
+    value = 1e-20F;
+    FilterDenormal::flush(value);
+    TEST_ASSERT_EQUAL_FLOAT(1e-20F, value);
+
+    xyz_t xyz { 1e-35F, 2.0F, -1e-38F };
+    FilterDenormal::flush(xyz);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, xyz.x);
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, xyz.y);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, xyz.z);
+}
+
+void test_power_transfer_filter_flush_denormals()
+{
+    PowerTransferFilter3 filter(0.1F);
+    filter.filter(1.0F);
+    filter.flush_denormals();
+    // normal state is unchanged
+    TEST_ASSERT_TRUE(filter.get_state()[0] > 0.0F);
+
+    // decay until the state is tiny, without flushing
+    for (int ii = 0; ii < 5000; ++ii) {
+        filter.filter(0.0F);
+    }
+    TEST_ASSERT_TRUE(filter.get_state()[0] > 0.0F);
+    TEST_ASSERT_TRUE(filter.get_state()[0] < FilterDenormal::THRESHOLD);
+    filter.flush_denormals();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state()[2]);
+
+    PowerTransferFilter1 filter1(0.1F);
+    filter1.filter(1e-35F);
+    filter1.flush_denormals();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter1.get_state());
+}
+
+void test_biquad_filter_flush_denormals()
+{
+    BiquadFilter filter;
+    filter.init_lowpass(100.0F, 0.001F, 0.7071F);
+    filter.filter(1.0F);
+    filter.filter(1e-35F);
+    filter.flush_denormals();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().x1);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, filter.get_state().x2);
+    TEST_ASSERT_TRUE(filter.get_state().y1 != 0.0F);
+    TEST_ASSERT_TRUE(filter.get_state().y2 != 0.0F);
+}
+
+void test_filter_templates_flush_denormals()
+{
+    BiquadFilterT<xyz_t> filter;
+    filter.init_lowpass(100.0F, 0.001F, 0.7071F);
+    filter.filter(xyz_t { 1.0F, 1e-35F, 1.0F });
+    filter.flush_denormals();
+    const xyz_t output = filter.filter(xyz_t { 0.0F, 0.0F, 0.0F });
+    TEST_ASSERT_TRUE(output.x > 0.0F);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, output.y);
+    TEST_ASSERT_TRUE(output.z > 0.0F);
+
+    PowerTransferFilter2T<xyz_t> filter2(0.5F);
+    filter2.filter(xyz_t { 1e-35F, 1.0F, 1e-35F });
+    filter2.flush_denormals();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter2.get_state()[1].x);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, filter2.get_state()[1].y);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter2.get_state()[1].z);
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_denormal_guard);
+    RUN_TEST(test_denormal_guard_nested);
+    RUN_TEST(test_filter_denormal_flush);
+    RUN_TEST(test_power_transfer_filter_flush_denormals);
+    RUN_TEST(test_biquad_filter_flush_denormals);
+    RUN_TEST(test_filter_templates_flush_denormals);
+
+    UNITY_END();
+}
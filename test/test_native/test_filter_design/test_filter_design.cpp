@@ -0,0 +1,134 @@
+#include "biquad_cascade.h"
+#include "filter_design.h"
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+template <size_t N>
+static double magnitude(const std::array<biquad_coefficients_t, N>& sections, double frequency_hz, double looptime_seconds)
+{
+    const std::complex<double> z1 = std::polar(1.0, -2.0*FilterDesign::PI*frequency_hz*looptime_seconds); // z^-1
+    std::complex<double> h = 1.0;
+    for (const auto& c : sections) {
+        const std::complex<double> numerator = static_cast<double>(c.b0) + z1*(static_cast<double>(c.b1) + z1*static_cast<double>(c.b2));
+        const std::complex<double> denominator = 1.0 + z1*(static_cast<double>(c.a1) + z1*static_cast<double>(c.a2));
+        h *= numerator/denominator;
+    }
+    return std::abs(h);
+}
+
+void test_filter_design_maths()
+{
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 1.4142135623730951, FilterDesign::sqrt(2.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 2.718281828459045, FilterDesign::exp(1.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 22026.465794806718, FilterDesign::exp(10.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 2.302585092994046, FilterDesign::log(10.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, -2.302585092994046, FilterDesign::log(0.1));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 0.881373587019543, FilterDesign::asinh(1.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 0.5, FilterDesign::sin(FilterDesign::PI/6.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 0.5, FilterDesign::cos(FilterDesign::PI/3.0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 1.0, FilterDesign::tan(FilterDesign::PI/4.0));
+}
+
+void test_filter_design_maths_limits()
+{
+    // these previously looped forever reducing the argument
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    TEST_ASSERT_TRUE(FilterDesign::log(0.0) == -INF);
+    TEST_ASSERT_TRUE(FilterDesign::log(INF) == INF);
+    TEST_ASSERT_TRUE(std::isnan(FilterDesign::log(-1.0)));
+    TEST_ASSERT_TRUE(std::isnan(FilterDesign::log(std::numeric_limits<double>::quiet_NaN())));
+    TEST_ASSERT_TRUE(FilterDesign::exp(INF) == INF);
+    TEST_ASSERT_TRUE(FilterDesign::exp(-INF) == 0.0);
+    TEST_ASSERT_TRUE(FilterDesign::asinh(INF) == INF);
+}
+
+void test_filter_design_butterworth()
+{
+    // evaluated at compile time
+    static constexpr auto BUTTERWORTH2 = FilterDesign::butterworth_lowpass<2>(100.0F, 0.001F);
+    static_assert(BUTTERWORTH2.size() == 1);
+    static_assert(BUTTERWORTH2[0].b0 > 0.067F && BUTTERWORTH2[0].b0 < 0.068F);
+    // reference values from scipy.signal.butter(2, 0.2)
+    TEST_ASSERT_EQUAL_FLOAT(0.06745527F, BUTTERWORTH2[0].b0);
+    TEST_ASSERT_EQUAL_FLOAT(0.13491055F, BUTTERWORTH2[0].b1);
+    TEST_ASSERT_EQUAL_FLOAT(0.06745527F, BUTTERWORTH2[0].b2);
+    TEST_ASSERT_EQUAL_FLOAT(-1.1429805F, BUTTERWORTH2[0].a1);
+    TEST_ASSERT_EQUAL_FLOAT(0.4128016F, BUTTERWORTH2[0].a2);
+
+    // second order Butterworth is the same as BiquadFilter::init_lowpass with q = 1/sqrt(2)
+    BiquadFilter designed; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter reference; // NOLINT(cppcoreguidelines-init-variables)
+    designed.set_parameters(BUTTERWORTH2[0]);
+    reference.init_lowpass(100.0F, 0.001F, 0.70710678F);
+    for (size_t ii = 0; ii < 20; ++ii) {
+        const float input = static_cast<float>(ii % 4);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input), designed.filter(input));
+    }
+
+    static constexpr auto BUTTERWORTH5 = FilterDesign::butterworth_lowpass<5>(200.0F, 0.000125F);
+    static_assert(BUTTERWORTH5.size() == 3);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, BUTTERWORTH5[0].a2); // first order section
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, magnitude(BUTTERWORTH5, 0.0, 0.000125));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.70710678, magnitude(BUTTERWORTH5, 200.0, 0.000125));
+    TEST_ASSERT_TRUE(magnitude(BUTTERWORTH5, 800.0, 0.000125) < 0.001);
+}
+
+void test_filter_design_chebyshev()
+{
+    static constexpr auto CHEBYSHEV4 = FilterDesign::chebyshev_lowpass<4>(100.0F, 0.001F, 1.0F);
+    const double ripple_gain = 1.0/std::sqrt(1.0 + (std::pow(10.0, 0.1) - 1.0)); // -1dB
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, ripple_gain, magnitude(CHEBYSHEV4, 0.0, 0.001));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, ripple_gain, magnitude(CHEBYSHEV4, 100.0, 0.001));
+    TEST_ASSERT_TRUE(magnitude(CHEBYSHEV4, 50.0, 0.001) <= 1.0001);
+    TEST_ASSERT_TRUE(magnitude(CHEBYSHEV4, 50.0, 0.001) >= ripple_gain - 1e-4);
+
+    static constexpr auto CHEBYSHEV3 = FilterDesign::chebyshev_lowpass<3>(100.0F, 0.001F, 0.5F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 1.0, magnitude(CHEBYSHEV3, 0.0, 0.001));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 1.0/std::sqrt(std::pow(10.0, 0.05)), magnitude(CHEBYSHEV3, 100.0, 0.001));
+}
+
+void test_filter_design_bessel()
+{
+    static constexpr auto BESSEL4 = FilterDesign::bessel_lowpass<4>(100.0F, 0.001F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 1.0, magnitude(BESSEL4, 0.0, 0.001));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.70710678, magnitude(BESSEL4, 100.0, 0.001));
+
+    static constexpr auto BESSEL7 = FilterDesign::bessel_lowpass<7>(50.0F, 0.001F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.70710678, magnitude(BESSEL7, 50.0, 0.001));
+}
+
+void test_filter_design_cascade()
+{
+    static constexpr auto BUTTERWORTH4 = FilterDesign::butterworth_lowpass<4>(100.0F, 0.001F);
+    BiquadCascade<2> filter(BUTTERWORTH4);
+    // step response settles to unity DC gain
+    float output = 0.0F;
+    for (size_t ii = 0; ii < 500; ++ii) {
+        output = filter.filter(1.0F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, 1.0F, output);
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_filter_design_maths);
+    RUN_TEST(test_filter_design_maths_limits);
+    RUN_TEST(test_filter_design_butterworth);
+    RUN_TEST(test_filter_design_chebyshev);
+    RUN_TEST(test_filter_design_bessel);
+    RUN_TEST(test_filter_design_cascade);
+
+    UNITY_END();
+}
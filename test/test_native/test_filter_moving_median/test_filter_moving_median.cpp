@@ -0,0 +1,177 @@
+#include "filter_moving_median.h"
+#include <algorithm>
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+float random_value(uint32_t& seed)
+{
+    seed = seed*1664525U + 1013904223U;
+    return static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U) - 0.5F;
+}
+
+//! median of the last `n` values in `history`, by sorting
+float sorted_median(const std::vector<float>& history, size_t n)
+{
+    const size_t count = std::min(n, history.size());
+    std::vector<float> window(history.end() - static_cast<std::ptrdiff_t>(count), history.end());
+    std::sort(window.begin(), window.end());
+    return (count % 2 == 1) ? window[count/2] : (window[count/2 - 1] + window[count/2])*0.5F;
+}
+
+//! true if `input`, the last value in `history`, is an outlier in the window of the last `n` values, using a sorted MAD
+bool sorted_is_outlier(const std::vector<float>& history, size_t n, float n_sigmas)
+{
+    const size_t count = std::min(n, history.size());
+    const float median = sorted_median(history, n);
+    std::vector<float> deviations;
+    for (auto it = history.end() - static_cast<std::ptrdiff_t>(count); it != history.end(); ++it) {
+        deviations.push_back(std::fabs(*it - median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    return std::fabs(history.back() - median) > n_sigmas*1.4826F*deviations[count/2];
+}
+
+template <size_t N>
+void check_against_sort(uint32_t seed)
+{
+    FilterMovingMedian<N> filter;
+    std::vector<float> history;
+    for (int ii = 0; ii < 1000; ++ii) {
+        // include repeated values, which exercise the equal comparisons in the heaps
+        const float input = (ii % 7 == 0) ? 0.25F : random_value(seed);
+        history.push_back(input);
+        TEST_ASSERT_EQUAL_FLOAT(sorted_median(history, N), filter.filter(input));
+    }
+    TEST_ASSERT_EQUAL(N, filter.size());
+}
+} // end namespace
+
+void test_moving_median()
+{
+    FilterMovingMedian<5> filter;
+    TEST_ASSERT_EQUAL(5, filter.capacity());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.median());
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter(2.0F));
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.filter(8.0F)); // mean of 2 and 8
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, filter.filter(3.0F));
+    TEST_ASSERT_EQUAL_FLOAT(2.5F, filter.filter(1.0F));
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, filter.filter(100.0F)); // {2, 8, 3, 1, 100}
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.filter(4.0F)); // {8, 3, 1, 100, 4}
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.filter(5.0F)); // {3, 1, 100, 4, 5}
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.filter(6.0F)); // {1, 100, 4, 5, 6}
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.median());
+    // a single spike is removed entirely
+    FilterMovingMedian<5> spike;
+    for (int ii = 0; ii < 10; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(1.0F, spike.filter(ii == 6 ? 1000.0F : 1.0F));
+    }
+    filter.reset();
+    TEST_ASSERT_EQUAL(0, filter.size());
+    TEST_ASSERT_EQUAL_FLOAT(7.0F, filter.filter_virtual(7.0F));
+}
+
+void test_moving_median_against_sort()
+{
+    check_against_sort<2>(1);
+    check_against_sort<3>(2);
+    check_against_sort<6>(3);
+    check_against_sort<31>(4);
+    check_against_sort<64>(5);
+    check_against_sort<255>(6);
+}
+
+void test_moving_median_block()
+{
+    FilterMovingMedian<7> filter;
+    FilterMovingMedian<7> reference;
+    std::array<float, 40> data {};
+    uint32_t seed = 7;
+    for (auto& value : data) {
+        value = random_value(seed);
+    }
+    std::array<float, 40> output {};
+    filter.filter_block(&data[0], &output[0], data.size());
+    for (size_t ii = 0; ii < data.size(); ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter(data[ii]), output[ii]);
+    }
+}
+
+void test_hampel()
+{
+    FilterHampel<9> filter;
+    uint32_t seed = 11;
+    std::vector<float> history;
+    for (int ii = 0; ii < 1000; ++ii) {
+        const float noise = 0.1F*random_value(seed);
+        const float signal = sinf(0.01F*static_cast<float>(ii));
+        const bool spike = (ii % 50 == 25);
+        const float input = signal + noise + (spike ? 5.0F : 0.0F);
+        history.push_back(input);
+        const float output = filter.filter(input);
+        // the same outliers as found using a sorted window
+        TEST_ASSERT_EQUAL(sorted_is_outlier(history, 9, 3.0F), filter.is_outlier());
+        if (spike) {
+            // spikes are replaced by the median, so are close to the signal
+            TEST_ASSERT_TRUE(filter.is_outlier());
+            TEST_ASSERT_FLOAT_WITHIN(0.1F, signal, output);
+        }
+        if (!filter.is_outlier()) {
+            // other inputs are passed through unchanged
+            TEST_ASSERT_EQUAL_FLOAT(input, output);
+        }
+    }
+
+    // a step is not an outlier once it fills more than half the window, and is delayed by that
+    filter.reset();
+    for (int ii = 0; ii < 9; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.filter(0.0F));
+    }
+    for (int ii = 0; ii < 4; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.filter(1.0F));
+        TEST_ASSERT_TRUE(filter.is_outlier());
+    }
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, filter.filter(1.0F));
+    TEST_ASSERT_FALSE(filter.is_outlier());
+}
+
+void test_hampel_threshold()
+{
+    // window {0, 0, 0, 1, -1, 1, -1}, median 0, MAD 1
+    FilterHampel<7> filter(2.0F);
+    const std::array<float, 6> window {{ 0.0F, 0.0F, 1.0F, -1.0F, 1.0F, -1.0F }};
+    for (const float value : window) {
+        filter.filter(value);
+    }
+    // 2.9 is within 2*1.4826 of the median
+    TEST_ASSERT_EQUAL_FLOAT(2.9F, filter.filter(2.9F));
+    TEST_ASSERT_FALSE(filter.is_outlier());
+
+    filter.reset();
+    for (const float value : window) {
+        filter.filter(value);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.filter(3.0F));
+    TEST_ASSERT_TRUE(filter.is_outlier());
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_moving_median);
+    RUN_TEST(test_moving_median_against_sort);
+    RUN_TEST(test_moving_median_block);
+    RUN_TEST(test_hampel);
+    RUN_TEST(test_hampel_threshold);
+
+    UNITY_END();
+}
@@ -0,0 +1,165 @@
+#include "filter_parallel.h"
+#include <unity.h>
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+float random_value(uint32_t& seed)
+{
+    seed = seed*1664525U + 1013904223U;
+    return static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U) - 0.5F;
+}
+
+//! a slow sine with noise, so lowpass outputs are not close to zero
+std::vector<float> make_signal(size_t count)
+{
+    std::vector<float> signal(count);
+    uint32_t seed = 12345;
+    for (size_t ii = 0; ii < count; ++ii) {
+        signal[ii] = std::sin(static_cast<float>(ii)*0.001F) + random_value(seed);
+    }
+    return signal;
+}
+
+/*!
+Filters `signal` serially and in parallel with each of the thread counts, starting from the state of `filter`,
+and checks the outputs and final states match.
+*/
+template <typename FILTER>
+void check_against_serial(const FILTER& filter, const std::vector<float>& signal, float tolerance)
+{
+    using traits_t = FilterStateTraits<FILTER>;
+    FILTER serial = filter;
+    std::vector<float> expected(signal.size());
+    for (size_t ii = 0; ii < signal.size(); ++ii) {
+        expected[ii] = serial.filter(signal[ii]);
+    }
+    for (const size_t thread_count : { 1U, 2U, 3U, 7U }) {
+        FilterThreadPool pool(thread_count);
+        FilterParallel<FILTER> parallel(pool);
+        FILTER filter_parallel = filter;
+        std::vector<float> output(signal.size());
+        parallel.filter_block(filter_parallel, signal.data(), output.data(), signal.size());
+        for (size_t ii = 0; ii < signal.size(); ++ii) {
+            TEST_ASSERT_FLOAT_WITHIN(tolerance, expected[ii], output[ii]);
+        }
+        const typename traits_t::vector_t state_serial = traits_t::get(serial);
+        const typename traits_t::vector_t state_parallel = traits_t::get(filter_parallel);
+        for (size_t ii = 0; ii < traits_t::SIZE; ++ii) {
+            TEST_ASSERT_FLOAT_WITHIN(tolerance, state_serial[ii], state_parallel[ii]);
+        }
+    }
+}
+} // end namespace
+
+void test_thread_pool()
+{
+    FilterThreadPool pool(4);
+    TEST_ASSERT_EQUAL(4, pool.thread_count());
+    std::vector<size_t> counts(100);
+    for (size_t run = 0; run < 10; ++run) {
+        pool.run(counts.size(), [&counts](size_t index) { ++counts[index]; });
+    }
+    for (const size_t count : counts) {
+        TEST_ASSERT_EQUAL(10, count);
+    }
+    // no tasks
+    pool.run(0, [&counts](size_t index) { ++counts[index]; });
+    TEST_ASSERT_EQUAL(10, counts[0]);
+}
+
+void test_transition()
+{
+    PowerTransferFilter2 filter;
+    filter.init(0.25F);
+    using parallel_t = FilterParallel<PowerTransferFilter2>;
+    const parallel_t::affine_t single = parallel_t::transition(filter);
+    const parallel_t::affine_t chunk = parallel_t::transition(filter, 5);
+    // applying the single sample transition 5 times to a state gives the same result as the chunk transition
+    filter.set_state(std::array<float, 2> {{ 1.0F, -0.5F }});
+    for (size_t ii = 0; ii < 5; ++ii) {
+        filter.filter(0.0F);
+    }
+    const std::array<float, 2> state = filter.get_state();
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, state[0], static_cast<float>(chunk.matrix[0]*1.0 - chunk.matrix[1]*0.5));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, state[1], static_cast<float>(chunk.matrix[2]*1.0 - chunk.matrix[3]*0.5));
+    // zero input from zero state stays at zero, so there is no offset
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, static_cast<float>(single.offset[0]));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, static_cast<float>(single.offset[1]));
+}
+
+void test_power_transfer_filters_parallel()
+{
+    for (const size_t count : { 100U, 10000U, 50001U }) {
+        const std::vector<float> signal = make_signal(count);
+
+        PowerTransferFilter1 pt1;
+        pt1.set_cutoff_frequency(50.0F, 0.001F);
+        pt1.set_state(0.75F);
+        check_against_serial(pt1, signal, 2e-5F);
+
+        PowerTransferFilter2 pt2;
+        pt2.set_cutoff_frequency(20.0F, 0.001F);
+        pt2.set_state(std::array<float, 2> {{ -0.5F, 0.25F }});
+        check_against_serial(pt2, signal, 2e-5F);
+
+        PowerTransferFilter3 pt3;
+        pt3.set_cutoff_frequency(100.0F, 0.001F);
+        pt3.set_state(std::array<float, 3> {{ 1.0F, 0.5F, -0.25F }});
+        check_against_serial(pt3, signal, 2e-5F);
+    }
+}
+
+void test_biquad_filters_parallel()
+{
+    for (const size_t count : { 100U, 10000U, 50001U }) {
+        const std::vector<float> signal = make_signal(count);
+
+        BiquadFilter low_pass;
+        low_pass.init_lowpass(30.0F, 0.001F, 0.7071F);
+        low_pass.reset_to(0.5F);
+        check_against_serial(low_pass, signal, 5e-5F);
+
+        BiquadFilter notch;
+        notch.init_notch(150.0F, 0.001F, 2.0F);
+        notch.set_state(BiquadFilter::state_t { 0.1F, -0.2F, 0.3F, -0.4F });
+        check_against_serial(notch, signal, 5e-5F);
+    }
+}
+
+void test_filter_parallel_short()
+{
+    // signals shorter than MIN_CHUNK_LENGTH are filtered serially, including an empty signal
+    FilterThreadPool pool(4);
+    FilterParallel<PowerTransferFilter1> parallel(pool);
+    PowerTransferFilter1 filter;
+    filter.init(0.5F);
+    parallel.filter_block(filter, nullptr, nullptr, 0);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state());
+    const std::array<float, 2> input {{ 1.0F, 1.0F }};
+    std::array<float, 2> output {};
+    parallel.filter_block(filter, input.data(), output.data(), input.size());
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, output[0]);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, output[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.75F, filter.get_state());
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_thread_pool);
+    RUN_TEST(test_transition);
+    RUN_TEST(test_power_transfer_filters_parallel);
+    RUN_TEST(test_biquad_filters_parallel);
+    RUN_TEST(test_filter_parallel_short);
+
+    UNITY_END();
+}
@@ -2,6 +2,9 @@
 #include <unity.h>
 #include <xyz_type.h>
 
+//! Opt `xyz_t` in to being filtered in a single SIMD register, see `FilterLaneTraits`.
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
 
 void setUp() {
 }
@@ -183,6 +186,119 @@ void test_power_transfer_filter1_xyz()
     TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter({2.0F, 0.0F, 0.0F}).x);
 }
 
+void test_power_transfer_filter_n_float()
+{
+    // matches the hand-written filters
+    PowerTransferFilterN<1> pt1n(100.0F, 0.001F);
+    PowerTransferFilterN<2> pt2n(100.0F, 0.001F);
+    PowerTransferFilterN<3> pt3n(100.0F, 0.001F);
+    PowerTransferFilter1T<float> pt1(100.0F, 0.001F);
+    PowerTransferFilter2T<float> pt2(100.0F, 0.001F);
+    PowerTransferFilter3T<float> pt3(100.0F, 0.001F);
+    TEST_ASSERT_EQUAL_FLOAT(PowerTransferFilter2T<float>::gain_from_frequency(100.0F, 0.001F), PowerTransferFilterN<2>::gain_from_frequency(100.0F, 0.001F));
+    TEST_ASSERT_EQUAL_FLOAT(PowerTransferFilter3T<float>::gain_from_delay(0.01F, 0.001F), PowerTransferFilterN<3>::gain_from_delay(0.01F, 0.001F));
+    for (size_t ii = 0; ii < 100; ++ii) {
+        const float input = sinf(0.2F*static_cast<float>(ii)) + 0.5F;
+        TEST_ASSERT_EQUAL_FLOAT(pt1.filter(input), pt1n.filter(input));
+        TEST_ASSERT_EQUAL_FLOAT(pt2.filter(input), pt2n.filter(input));
+        TEST_ASSERT_EQUAL_FLOAT(pt3.filter(input), pt3n.filter(input));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(pt3.get_state()[2], pt3n.get_state()[2]);
+
+    // default settings perform no filtering
+    PowerTransferFilterN<8> pt8;
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, pt8.filter(2.0F));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0F, pt8.filter(-1.0F));
+
+    // the -3dB point of the whole filter is at the cutoff frequency
+    pt8.set_cutoff_frequency_and_reset(10.0F, 0.0001F);
+    float amplitude = 0.0F;
+    for (size_t ii = 0; ii < 20000; ++ii) {
+        const float output = pt8.filter(sinf(2.0F*3.14159265F*10.0F*0.0001F*static_cast<float>(ii)));
+        if (ii >= 10000) {
+            amplitude = std::max(amplitude, std::fabs(output));
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 0.7071F, amplitude);
+
+    // variable time step, the same gain as setting the cutoff frequency every sample
+    PowerTransferFilterN<4> pt4(100.0F, 0.001F);
+    PowerTransferFilterN<4> pt4_reference(100.0F, 0.001F);
+    PowerTransferFilter2T<float> pt2_dt(100.0F, 0.001F);
+    PowerTransferFilter2T<float> pt2_reference(100.0F, 0.001F);
+    for (size_t ii = 0; ii < 200; ++ii) {
+        const float dt = 0.001F*(1.0F + 0.2F*sinf(1.3F*static_cast<float>(ii)));
+        pt4_reference.set_cutoff_frequency(100.0F, dt);
+        pt2_reference.set_cutoff_frequency(100.0F, dt);
+        TEST_ASSERT_EQUAL_FLOAT(pt4_reference.filter(1.0F), pt4.filter_variable_dt(1.0F, dt));
+        TEST_ASSERT_EQUAL_FLOAT(pt2_reference.filter(1.0F), pt2_dt.filter_variable_dt(1.0F, dt));
+    }
+
+    pt8.set_to_passthrough();
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, pt8.filter(3.0F));
+    pt8.reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, pt8.get_state()[7]);
+}
+
+void test_power_transfer_filter_n_block_xyz()
+{
+    PowerTransferFilterN<5, xyz_t> filter(0.2F);
+    PowerTransferFilterN<5, xyz_t> block(0.2F);
+    std::array<xyz_t, 40> input {};
+    std::array<xyz_t, 40> output {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        const float t = static_cast<float>(ii);
+        input[ii] = xyz_t { sinf(0.1F*t), cosf(0.37F*t), 1.0F };
+    }
+    block.filter_block(&input[0], &output[0], 25);
+    block.filter_block(&input[25], &output[25], input.size() - 25);
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        const xyz_t expected = filter.filter(input[ii]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, expected.x, output[ii].x);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, expected.y, output[ii].y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, expected.z, output[ii].z);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, filter.get_state()[4].y, block.get_state()[4].y);
+
+    // in-place
+    block.reset();
+    block.filter_block(&input[0], input.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, output[input.size() - 1].x, input[input.size() - 1].x);
+}
+
+void test_reset_to_xyz()
+{
+    const xyz_t value { 1.0F, -2.0F, 3.0F };
+
+    PowerTransferFilter1T<xyz_t> pt1(10.0F, 0.001F);
+    PowerTransferFilter3T<xyz_t> pt3(10.0F, 0.001F);
+    PowerTransferFilterN<6, xyz_t> pt6(10.0F, 0.001F);
+    BiquadFilterT<xyz_t> biquad;
+    biquad.init_lowpass(100.0F, 0.001F, 0.7071F);
+    pt1.reset_to(value);
+    pt3.reset_to(value);
+    pt6.reset_to(value);
+    biquad.reset_to(value);
+    for (size_t ii = 0; ii < 20; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(-2.0F, pt1.filter(value).y);
+        TEST_ASSERT_EQUAL_FLOAT(3.0F, pt3.filter(value).z);
+        TEST_ASSERT_EQUAL_FLOAT(1.0F, pt6.filter(value).x);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, -2.0F, biquad.filter(value).y);
+    }
+
+    FilterMovingAverageT<xyz_t, 4> average;
+    average.reset_to(value);
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, average.filter(value).z);
+    const xyz_t output = average.filter(xyz_t { 5.0F, 2.0F, 7.0F }); // displaces one value
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, output.x);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0F, output.y);
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, output.z);
+
+    FilterNullT<xyz_t> null;
+    null.reset_to(value);
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, null.filter(xyz_t { 5.0F, 0.0F, 0.0F }).x);
+}
+
 void test_biquad_filter_float()
 {
     BiquadFilterT<float> filter;
@@ -247,6 +363,126 @@ void test_biquad_filter_xyz()
     TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter_weighted({2.0F, 0.0F, 0.0F}).x);
 }
 
+void test_biquad_filter_block_xyz()
+{
+    BiquadFilterT<xyz_t> filter;
+    BiquadFilterT<xyz_t> reference;
+    filter.init_notch(50.0F, 0.001F, 2.0F);
+    reference.init_notch(50.0F, 0.001F, 2.0F);
+
+    std::array<xyz_t, 8> input {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        const float value = static_cast<float>(ii);
+        input[ii] = xyz_t{value, -value, 2.0F*value};
+    }
+    std::array<xyz_t, 8> data = input;
+    filter.filter_block(&data[0], data.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        const xyz_t expected = reference.filter(input[ii]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.x, data[ii].x);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.y, data[ii].y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.z, data[ii].z);
+    }
+    const xyz_t expected = reference.filter({1.0F, 2.0F, 3.0F});
+    const xyz_t output = filter.filter({1.0F, 2.0F, 3.0F});
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.x, output.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.y, output.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected.z, output.z);
+}
+
+namespace {
+struct xyzw_t {
+    float x;
+    float y;
+    float z;
+    float w;
+    xyzw_t operator+(const xyzw_t& v) const { return xyzw_t{x + v.x, y + v.y, z + v.z, w + v.w}; }
+    xyzw_t operator-(const xyzw_t& v) const { return xyzw_t{x - v.x, y - v.y, z - v.z, w - v.w}; }
+    xyzw_t operator*(float k) const { return xyzw_t{x*k, y*k, z*k, w*k}; }
+};
+
+//! A 3 component vector that is not opted in to lane packing.
+struct xyz_unpacked_t {
+    float x;
+    float y;
+    float z;
+};
+} // end namespace
+
+template <>
+struct FilterLaneTraits<xyzw_t> : FilterVectorLaneTraits<xyzw_t> {};
+
+namespace {
+
+template <typename FILTER, typename FILTER_FLOAT>
+void check_vector_filter_matches_float_filters(FILTER& filter, std::array<FILTER_FLOAT, 3>& filters)
+{
+    for (size_t ii = 0; ii < 200; ++ii) {
+        const float t = static_cast<float>(ii);
+        const xyz_t input { sinf(0.1F*t), cosf(0.37F*t), 0.5F - sinf(0.05F*t) };
+        const xyz_t output = filter.filter(input);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, filters[0].filter(input.x), output.x);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, filters[1].filter(input.y), output.y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, filters[2].filter(input.z), output.z);
+    }
+}
+} // end namespace
+
+void test_filter_lanes_xyz()
+{
+#if defined(LIBRARY_FILTER_SIMD_SSE) || defined(LIBRARY_FILTER_SIMD_NEON)
+    static_assert(std::is_same_v<FilterLaneTraits<xyz_t>::lanes_t, FilterLanes4>);
+    static_assert(std::is_same_v<FilterLaneTraits<xyzw_t>::lanes_t, FilterLanes4>);
+#endif
+    static_assert(std::is_same_v<FilterLaneTraits<float>::lanes_t, float>);
+    static_assert(std::is_same_v<FilterLaneTraits<xyz_unpacked_t>::lanes_t, xyz_unpacked_t>);
+    // state that is not held in lanes is returned by reference
+    static_assert(std::is_same_v<decltype(PowerTransferFilter1T<float>().get_state()), const float&>);
+    static_assert(std::is_same_v<decltype(PowerTransferFilter3T<float>().get_state()), const std::array<float, 3>&>);
+    static_assert(std::is_same_v<decltype(BiquadFilterT<float>().get_state()), const BiquadFilterT<float>::state_t&>);
+
+    // each component of the vector filter matches the float filter
+    PowerTransferFilter1T<xyz_t> pt1(0.2F);
+    std::array<PowerTransferFilter1T<float>, 3> pt1s {{ PowerTransferFilter1T<float>(0.2F), PowerTransferFilter1T<float>(0.2F), PowerTransferFilter1T<float>(0.2F) }};
+    check_vector_filter_matches_float_filters(pt1, pt1s);
+
+    PowerTransferFilter3T<xyz_t> pt3(0.2F);
+    std::array<PowerTransferFilter3T<float>, 3> pt3s {{ PowerTransferFilter3T<float>(0.2F), PowerTransferFilter3T<float>(0.2F), PowerTransferFilter3T<float>(0.2F) }};
+    check_vector_filter_matches_float_filters(pt3, pt3s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, pt3s[1].get_state()[2], pt3.get_state()[2].y);
+
+    BiquadFilterT<xyz_t> biquad;
+    biquad.init_lowpass(80.0F, 0.001F, 0.7071F);
+    std::array<BiquadFilterT<float>, 3> biquads {};
+    for (auto& filter : biquads) {
+        filter.init_lowpass(80.0F, 0.001F, 0.7071F);
+    }
+    check_vector_filter_matches_float_filters(biquad, biquads);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, biquads[2].get_state().y2, biquad.get_state().y2.z);
+
+    biquad.set_weight(0.25F);
+    const xyz_t output = biquad.filter_weighted({ 1.0F, 2.0F, 3.0F });
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, biquads[0].filter(1.0F)*0.25F + 0.75F, output.x);
+}
+
+void test_filter_lanes_xyzw()
+{
+    BiquadFilterT<xyzw_t> filter;
+    BiquadFilterT<float> reference;
+    filter.init_notch(50.0F, 0.001F, 2.0F);
+    reference.init_notch(50.0F, 0.001F, 2.0F);
+    for (size_t ii = 0; ii < 50; ++ii) {
+        const float value = sinf(0.2F*static_cast<float>(ii));
+        const xyzw_t output = filter.filter(xyzw_t { value, 0.0F, 0.0F, -value });
+        const float expected = reference.filter(value);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, expected, output.x);
+        TEST_ASSERT_EQUAL_FLOAT(0.0F, output.y);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6F, -expected, output.w);
+    }
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().y1.w);
+}
+
 // NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
@@ -259,8 +495,14 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
     RUN_TEST(test_moving_average_filter_xyz);
     RUN_TEST(test_power_transfer_filter1_float);
     RUN_TEST(test_power_transfer_filter1_xyz);
+    RUN_TEST(test_power_transfer_filter_n_float);
+    RUN_TEST(test_power_transfer_filter_n_block_xyz);
+    RUN_TEST(test_reset_to_xyz);
     RUN_TEST(test_biquad_filter_float);
     RUN_TEST(test_biquad_filter_xyz);
+    RUN_TEST(test_biquad_filter_block_xyz);
+    RUN_TEST(test_filter_lanes_xyz);
+    RUN_TEST(test_filter_lanes_xyzw);
 
     UNITY_END();
 }
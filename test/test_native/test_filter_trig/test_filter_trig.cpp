@@ -0,0 +1,93 @@
+#include "filter_trig.h"
+#include "filters.h"
+#include "filter_templates.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+template <typename TRIG>
+static void check_max_error(float max_error)
+{
+    for (int ii = -2000; ii <= 2000; ++ii) {
+        const float x = 3.14159265F*static_cast<float>(ii)/2000.0F;
+        float sin_x {};
+        float cos_x {};
+        TRIG::sincos(x, sin_x, cos_x);
+        TEST_ASSERT_FLOAT_WITHIN(max_error, static_cast<float>(sin(static_cast<double>(x))), sin_x);
+        TEST_ASSERT_FLOAT_WITHIN(max_error, static_cast<float>(cos(static_cast<double>(x))), cos_x);
+    }
+}
+
+void test_trig_libm()
+{
+    check_max_error<TrigLibm>(1e-7F);
+}
+
+void test_trig_polynomial()
+{
+    check_max_error<TrigPolynomial>(1e-6F);
+    // arguments outside [-PI, PI] are reduced
+    float sin_x {};
+    float cos_x {};
+    TrigPolynomial::sincos(10.0F, sin_x, cos_x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, -0.5440211F, sin_x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, -0.8390715F, cos_x);
+}
+
+void test_trig_lookup_table()
+{
+    check_max_error<TrigLookupTable>(5e-6F);
+    float sin_x {};
+    float cos_x {};
+    TrigLookupTable::sincos(-10.0F, sin_x, cos_x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 0.5440211F, sin_x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, -0.8390715F, cos_x);
+}
+
+void test_biquad_filter_trig_policy()
+{
+    BiquadFilter libm; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter polynomial; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter lookup_table; // NOLINT(cppcoreguidelines-init-variables)
+    for (BiquadFilter* filter : { &libm, &polynomial, &lookup_table }) {
+        filter->init_notch(200.0F, 0.000125F, 3.0F);
+    }
+    libm.set_notch_frequency_weighted<TrigLibm>(250.0F, 0.8F);
+    polynomial.set_notch_frequency_weighted<TrigPolynomial>(250.0F, 0.8F);
+    lookup_table.set_notch_frequency_weighted<TrigLookupTable>(250.0F, 0.8F);
+    for (size_t ii = 0; ii < 100; ++ii) {
+        const float input = sinf(0.3F*static_cast<float>(ii));
+        const float expected = libm.filter_weighted(input);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, expected, polynomial.filter_weighted(input));
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, expected, lookup_table.filter_weighted(input));
+    }
+
+    BiquadFilterT<float> libm_t;
+    BiquadFilterT<float> polynomial_t;
+    libm_t.init_lowpass(100.0F, 0.001F, 0.7071F);
+    polynomial_t.init_lowpass(100.0F, 0.001F, 0.7071F);
+    libm_t.set_low_pass_frequencyWeighted<TrigLibm>(120.0F, 1.0F);
+    polynomial_t.set_low_pass_frequencyWeighted<TrigPolynomial>(120.0F, 1.0F);
+    for (size_t ii = 0; ii < 100; ++ii) {
+        const float input = static_cast<float>(ii % 9);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, libm_t.filter(input), polynomial_t.filter(input));
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_trig_libm);
+    RUN_TEST(test_trig_polynomial);
+    RUN_TEST(test_trig_lookup_table);
+    RUN_TEST(test_biquad_filter_trig_policy);
+
+    UNITY_END();
+}
@@ -36,6 +36,95 @@ void test_moving_average_filter()
     TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.filter(-9.0F));
 }
 
+void test_moving_average_filter_long_run()
+{
+    // the compensated sum stays within float rounding of the true window mean, however many samples are filtered
+    FilterMovingAverage<64, SumNeumaier<float>> filter;
+    std::array<float, 64> window {};
+    uint32_t seed = 5;
+    float output = 0.0F;
+    for (size_t ii = 0; ii < (1U << 22U); ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        const float input = 1000.0F*static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U);
+        window[ii % window.size()] = input;
+        output = filter.filter(input);
+    }
+    double mean = 0.0;
+    for (const float value : window) {
+        mean += static_cast<double>(value);
+    }
+    mean /= static_cast<double>(window.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(mean), output);
+
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.filter(4.0F));
+    TEST_ASSERT_EQUAL_FLOAT(12.0F, filter.filter(20.0F));
+}
+
+void test_multi_moving_average_filter()
+{
+    FilterMultiMovingAverage<4, 16, 3> filter;
+    TEST_ASSERT_EQUAL(3, filter.WINDOW_COUNT);
+    TEST_ASSERT_EQUAL(16, filter.MAX_N);
+    TEST_ASSERT_EQUAL(3, filter.window_length(2));
+
+    // the same outputs as separate moving averages
+    FilterMovingAverage<4> filter4;
+    FilterMovingAverage<16> filter16;
+    FilterMovingAverage<3> filter3;
+    for (int ii = 0; ii < 100; ++ii) {
+        const auto input = static_cast<float>((ii*37) % 23);
+        const auto outputs = filter.filter(input);
+        TEST_ASSERT_EQUAL_FLOAT(filter4.filter(input), outputs[0]);
+        TEST_ASSERT_EQUAL_FLOAT(filter16.filter(input), outputs[1]);
+        TEST_ASSERT_EQUAL_FLOAT(filter3.filter(input), outputs[2]);
+        TEST_ASSERT_EQUAL_FLOAT(outputs[1], filter.get_output(1));
+    }
+
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.filter_virtual(4.0F));
+    TEST_ASSERT_EQUAL_FLOAT(12.0F, filter.filter_virtual(20.0F));
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.filter_virtual(-9.0F));
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.get_output(1));
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, filter.get_output(2));
+    filter.filter(1.0F);
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.get_output(0)); // {4, 20, -9, 1}
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.get_output(1));
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, filter.get_output(2)); // {20, -9, 1}
+
+    // the largest window is not a power of two, and the history is its length
+    FilterMultiMovingAverageSum<SumNeumaier<float>, 5, 12> compensated;
+    FilterMovingAverage<5, SumNeumaier<float>> filter5;
+    FilterMovingAverage<12, SumNeumaier<float>> filter12;
+    for (int ii = 0; ii < 100; ++ii) {
+        const auto input = static_cast<float>((ii*37) % 23) + 0.1F;
+        const auto outputs = compensated.filter(input, 0.001F);
+        TEST_ASSERT_EQUAL_FLOAT(filter5.filter(input), outputs[0]);
+        TEST_ASSERT_EQUAL_FLOAT(filter12.filter(input), outputs[1]);
+    }
+
+    // the history is not cleared by reset_to() or reset(), the samples left in it are not used
+    compensated.reset_to(2.0F);
+    filter5.reset_to(2.0F);
+    filter12.reset_to(2.0F);
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, compensated.get_output(1));
+    for (int ii = 0; ii < 30; ++ii) {
+        const auto input = static_cast<float>(ii % 7);
+        const auto outputs = compensated.filter(input);
+        TEST_ASSERT_EQUAL_FLOAT(filter5.filter(input), outputs[0]);
+        TEST_ASSERT_EQUAL_FLOAT(filter12.filter(input), outputs[1]);
+    }
+    compensated.reset();
+    filter5.reset();
+    filter12.reset();
+    for (int ii = 0; ii < 30; ++ii) {
+        const auto input = static_cast<float>(ii % 5);
+        const auto outputs = compensated.filter(input);
+        TEST_ASSERT_EQUAL_FLOAT(filter5.filter(input), outputs[0]);
+        TEST_ASSERT_EQUAL_FLOAT(filter12.filter(input), outputs[1]);
+    }
+}
+
 void test_power_transfer_filter1()
 {
     PowerTransferFilter1 filter; // NOLINT(cppcoreguidelines-init-variables)
@@ -127,6 +216,209 @@ void test_power_transfer_filter3()
     TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter(2.0F));
 }
 
+namespace {
+template <typename FILTER>
+void check_variable_dt_matches_set_cutoff_frequency(FILTER& filter, FILTER& reference)
+{
+    filter.set_cutoff_frequency_and_reset(100.0F, 0.001F);
+    reference.set_cutoff_frequency_and_reset(100.0F, 0.001F);
+    for (size_t ii = 0; ii < 1000; ++ii) {
+        const float t = static_cast<float>(ii);
+        const float dt = 0.001F*(1.0F + 0.2F*sinf(1.3F*t)); // 20% jitter
+        const float input = sinf(0.05F*t) + 0.5F;
+        reference.set_cutoff_frequency(100.0F, dt);
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter(input), filter.filter_variable_dt(input, dt));
+    }
+}
+} // end namespace
+
+void test_power_transfer_filter_variable_dt()
+{
+    PowerTransferFilter1 pt1;
+    PowerTransferFilter1 pt1_reference;
+    check_variable_dt_matches_set_cutoff_frequency(pt1, pt1_reference);
+    PowerTransferFilter2 pt2;
+    PowerTransferFilter2 pt2_reference;
+    check_variable_dt_matches_set_cutoff_frequency(pt2, pt2_reference);
+    PowerTransferFilter3 pt3;
+    PowerTransferFilter3 pt3_reference;
+    check_variable_dt_matches_set_cutoff_frequency(pt3, pt3_reference);
+
+    // the constructor with a cutoff frequency sets omega
+    PowerTransferFilter1 constructed(100.0F, 0.001F);
+    pt1.set_cutoff_frequency_and_reset(100.0F, 0.002F);
+    TEST_ASSERT_EQUAL_FLOAT(pt1.filter(1.0F), constructed.filter_variable_dt(1.0F, 0.002F));
+
+    // setting the cutoff frequency after init(k) gives the variable time step gain
+    pt3.init(0.5F);
+    pt3_reference.set_cutoff_frequency_and_reset(50.0F, 0.003F);
+    pt3.set_cutoff_frequency(50.0F, 0.001F);
+    TEST_ASSERT_EQUAL_FLOAT(pt3_reference.filter(1.0F), pt3.filter_variable_dt(1.0F, 0.003F));
+}
+
+namespace {
+//! checks that `advance(input, count)` gives the same output as `count` calls to `filter(input)`, and leaves the same state, by filtering a further sample
+template <typename FILTER>
+void check_advance_matches_filter(const FILTER& initial, float input, float tolerance)
+{
+    for (size_t count : { 1U, 2U, 3U, 7U, 64U, 1000U }) {
+        FILTER advanced = initial;
+        FILTER filtered = initial;
+        float output = 0.0F;
+        for (size_t ii = 0; ii < count; ++ii) {
+            output = filtered.filter(input);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(tolerance, output, advanced.advance(input, count));
+        TEST_ASSERT_FLOAT_WITHIN(tolerance, filtered.filter(-input), advanced.filter(-input));
+        TEST_ASSERT_FLOAT_WITHIN(tolerance, filtered.filter(0.0F), advanced.filter(0.0F));
+    }
+}
+
+template <typename FILTER>
+FILTER filtered_noise(FILTER filter)
+{
+    for (size_t ii = 0; ii < 20; ++ii) {
+        filter.filter(sinf(1.7F*static_cast<float>(ii)));
+    }
+    return filter;
+}
+} // end namespace
+
+void test_power_transfer_filter_advance()
+{
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, PowerTransferFilter1::power(0.5F, 0));
+    TEST_ASSERT_EQUAL_FLOAT(0.125F, PowerTransferFilter1::power(0.5F, 3));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, powf(0.9F, 37.0F), PowerTransferFilter1::power(0.9F, 37));
+
+    check_advance_matches_filter(filtered_noise(PowerTransferFilter1(100.0F, 0.001F)), 2.0F, 2e-6F);
+    check_advance_matches_filter(filtered_noise(PowerTransferFilter2(100.0F, 0.001F)), 2.0F, 2e-6F);
+    check_advance_matches_filter(filtered_noise(PowerTransferFilter3(100.0F, 0.001F)), 2.0F, 2e-6F);
+    check_advance_matches_filter(filtered_noise(PowerTransferFilter3(5.0F, 0.001F)), -1.0F, 2e-6F);
+
+    // advancing by zero samples leaves the state unchanged
+    PowerTransferFilter3 pt3 = filtered_noise(PowerTransferFilter3(100.0F, 0.001F));
+    const std::array<float, 3> state = pt3.get_state();
+    TEST_ASSERT_EQUAL_FLOAT(state[0], pt3.advance(5.0F, 0));
+    TEST_ASSERT_EQUAL_FLOAT(state[2], pt3.get_state()[2]);
+}
+
+void test_biquad_filter_advance()
+{
+    BiquadFilter lowpass;
+    lowpass.init_lowpass(100.0F, 0.001F, 0.7071F);
+    check_advance_matches_filter(filtered_noise(lowpass), 2.0F, 1e-5F);
+
+    BiquadFilter notch;
+    notch.init_notch(200.0F, 0.001F, 5.0F); // lightly damped, so the transient lasts
+    check_advance_matches_filter(filtered_noise(notch), -1.0F, 1e-5F);
+
+    // low cutoff, so the poles are near z = 1, against a loop in double precision
+    BiquadFilter low_cutoff;
+    low_cutoff.init_lowpass(1.0F, 1.0F/8000.0F, 0.7071F);
+    const biquad_coefficients_t c = low_cutoff.get_parameters();
+    double x1 = 0.0;
+    double x2 = 0.0;
+    double y1 = 0.0;
+    double y2 = 0.0;
+    for (size_t ii = 0; ii < 10000; ++ii) {
+        const double y = 2.0*static_cast<double>(c.b0) + x1*static_cast<double>(c.b1) + x2*static_cast<double>(c.b2) - y1*static_cast<double>(c.a1) - y2*static_cast<double>(c.a2);
+        x2 = x1;
+        x1 = 2.0;
+        y2 = y1;
+        y1 = y;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, static_cast<float>(y1), low_cutoff.advance(2.0F, 10000));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, static_cast<float>(y2), low_cutoff.get_state().y2);
+    check_advance_matches_filter(filtered_noise(low_cutoff), 2.0F, 1e-3F);
+
+    // a pole at z = 1 has no fixed point, eg an integrator
+    BiquadFilter integrator(-1.0F, 0.0F, 1.0F, 0.0F, 0.0F);
+    TEST_ASSERT_EQUAL_FLOAT(100.0F, integrator.advance(1.0F, 100));
+    TEST_ASSERT_EQUAL_FLOAT(101.0F, integrator.filter(1.0F));
+
+    // advancing by zero samples leaves the state unchanged
+    BiquadFilter filter = filtered_noise(lowpass);
+    const BiquadFilter::state_t state = filter.get_state();
+    TEST_ASSERT_EQUAL_FLOAT(state.y1, filter.advance(3.0F, 0));
+    TEST_ASSERT_EQUAL_FLOAT(state.x1, filter.get_state().x1);
+
+    // the ramp is stepped through sample by sample
+    BiquadFilterRamped ramped;
+    ramped.init_lowpass(100.0F, 0.001F, 0.7071F);
+    ramped.set_ramp_samples(10);
+    ramped.set_target_low_pass_frequency(50.0F);
+    check_advance_matches_filter(filtered_noise(ramped), 1.0F, 1e-5F);
+}
+
+void test_reset_to()
+{
+    FilterNull null;
+    null.reset_to(3.0F);
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, null.filter(2.0F));
+
+    // power transfer filters start in steady state, so a constant input gives a constant output
+    PowerTransferFilter1 pt1(10.0F, 0.001F);
+    PowerTransferFilter2 pt2(10.0F, 0.001F);
+    PowerTransferFilter3 pt3(10.0F, 0.001F);
+    pt1.reset_to(5.0F);
+    pt2.reset_to(5.0F);
+    pt3.reset_to(5.0F);
+    for (size_t ii = 0; ii < 10; ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(5.0F, pt1.filter(5.0F));
+        TEST_ASSERT_EQUAL_FLOAT(5.0F, pt2.filter(5.0F));
+        TEST_ASSERT_EQUAL_FLOAT(5.0F, pt3.filter(5.0F));
+    }
+
+    BiquadFilter lowpass;
+    lowpass.init_lowpass(100.0F, 0.001F, 0.7071F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 1.0F, lowpass.get_dc_gain());
+    lowpass.reset_to(2.0F);
+    BiquadFilter notch;
+    notch.init_notch(200.0F, 0.001F, 5.0F);
+    notch.reset_to(-3.0F);
+    BiquadFilter biquad(-0.5F, 0.25F, 0.3F, 0.2F, 0.1F); // DC gain 0.6/0.75
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.8F, biquad.get_dc_gain());
+    biquad.reset_to(4.0F);
+    for (size_t ii = 0; ii < 100; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, 2.0F, lowpass.filter(2.0F));
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, -3.0F, notch.filter(-3.0F));
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, 3.2F, biquad.filter(4.0F));
+    }
+
+    // moving averages behave as if the window were full of the value
+    FilterMovingAverage<8> average;
+    FilterMovingAverage<8> reference;
+    FilterMovingAverage<8, SumNeumaier<float>> compensated;
+    FilterMultiMovingAverage<4, 8> multi;
+    FilterMultiMovingAverage<4, 8> multi_reference;
+    average.reset_to(3.0F);
+    compensated.reset_to(3.0F);
+    multi.reset_to(3.0F);
+    for (size_t ii = 0; ii < 8; ++ii) {
+        reference.filter(3.0F);
+        multi_reference.filter(3.0F);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, multi.get_output(1));
+    for (size_t ii = 0; ii < 20; ++ii) {
+        const float input = static_cast<float>(ii*ii);
+        const float expected = reference.filter(input);
+        TEST_ASSERT_EQUAL_FLOAT(expected, average.filter(input));
+        TEST_ASSERT_EQUAL_FLOAT(expected, compensated.filter(input));
+        const auto outputs = multi.filter(input);
+        const auto expected_outputs = multi_reference.filter(input);
+        TEST_ASSERT_EQUAL_FLOAT(expected_outputs[0], outputs[0]);
+        TEST_ASSERT_EQUAL_FLOAT(expected_outputs[1], outputs[1]);
+        TEST_ASSERT_EQUAL_FLOAT(expected_outputs[1], multi.get_output(1));
+    }
+
+    // reset() returns to averaging the samples so far
+    average.reset();
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, average.filter(4.0F));
+    TEST_ASSERT_EQUAL_FLOAT(5.0F, average.filter(6.0F));
+    multi.reset();
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, multi.filter(4.0F)[1]);
+}
+
 void test_biquad_filter()
 {
     BiquadFilter filter; // NOLINT(cppcoreguidelines-init-variables)
@@ -147,6 +439,139 @@ void test_biquad_filter()
     TEST_ASSERT_EQUAL_FLOAT(2.0F, filter.filter_weighted(2.0F));
 }
 
+void test_biquad_filter_block()
+{
+    BiquadFilter filter; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilter reference; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_lowpass(100.0F, 0.001F, 0.7071F);
+    reference.init_lowpass(100.0F, 0.001F, 0.7071F);
+
+    std::array<float, 16> input {};
+    std::array<float, 16> output {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = static_cast<float>(ii % 5) - 2.0F + (ii == 3 ? 10.0F : 0.0F);
+    }
+
+    filter.filter_block(&input[0], &output[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input[ii]), output[ii]);
+    }
+    // state is restored, so per-sample filtering continues seamlessly after a block
+    TEST_ASSERT_EQUAL_FLOAT(reference.get_state().x1, filter.get_state().x1);
+    TEST_ASSERT_EQUAL_FLOAT(reference.get_state().x2, filter.get_state().x2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.get_state().y1, filter.get_state().y1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.get_state().y2, filter.get_state().y2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(1.0F), filter.filter(1.0F));
+
+    // single sample block
+    filter.filter_block(&input[0], &output[0], 1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input[0]), output[0]);
+
+    // in-place
+    std::array<float, 16> data = input;
+    filter.filter_block(&data[0], data.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input[ii]), data[ii]);
+    }
+}
+
+void test_biquad_filter_ramped()
+{
+    BiquadFilterRamped filter; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_notch(100.0F, 0.001F, 2.0F);
+    BiquadFilter reference; // NOLINT(cppcoreguidelines-init-variables)
+    reference.init_notch(200.0F, 0.001F, 2.0F);
+    const biquad_coefficients_t start = filter.get_parameters();
+    const biquad_coefficients_t target = reference.get_parameters();
+
+    // zero ramp samples sets the coefficients immediately
+    filter.set_target_notch_frequency(200.0F);
+    TEST_ASSERT_FALSE(filter.is_ramping());
+    TEST_ASSERT_EQUAL_FLOAT(target.a1, filter.get_parameters().a1);
+    TEST_ASSERT_EQUAL_FLOAT(target.b0, filter.get_parameters().b0);
+
+    filter.init_notch(100.0F, 0.001F, 2.0F);
+    filter.set_ramp_samples(10);
+    filter.set_target_notch_frequency_weighted(200.0F, 0.5F);
+    TEST_ASSERT_TRUE(filter.is_ramping());
+    // coefficients are unchanged until the next sample
+    TEST_ASSERT_EQUAL_FLOAT(start.a1, filter.get_parameters().a1);
+    for (int ii = 0; ii < 5; ++ii) {
+        filter.filter(0.0F);
+    }
+    // half way
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.5F*(start.a1 + target.a1), filter.get_parameters().a1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.5F*(start.a2 + target.a2), filter.get_parameters().a2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.5F*(start.b0 + target.b0), filter.get_parameters().b0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.75F, filter.get_weight());
+    for (int ii = 0; ii < 5; ++ii) {
+        filter.filter(0.0F);
+    }
+    // exactly on target at the end of the ramp
+    TEST_ASSERT_FALSE(filter.is_ramping());
+    TEST_ASSERT_EQUAL_FLOAT(target.a1, filter.get_parameters().a1);
+    TEST_ASSERT_EQUAL_FLOAT(target.a2, filter.get_parameters().a2);
+    TEST_ASSERT_EQUAL_FLOAT(target.b1, filter.get_parameters().b1);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, filter.get_weight());
+}
+
+void test_biquad_filter_ramped_retarget()
+{
+    BiquadFilterRamped filter; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_notch(100.0F, 0.001F, 2.0F);
+    filter.set_ramp_samples(10);
+    filter.set_target_notch_frequency_weighted(200.0F, 0.5F);
+    for (int ii = 0; ii < 5; ++ii) {
+        filter.filter(0.0F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.75F, filter.get_weight());
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, filter.get_target_weight());
+    // retargeting mid-ramp without a weight keeps the target weight, not the interpolated weight
+    filter.set_target_notch_frequency(150.0F);
+    for (int ii = 0; ii < 10; ++ii) {
+        filter.filter(0.0F);
+    }
+    TEST_ASSERT_FALSE(filter.is_ramping());
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, filter.get_weight());
+
+    filter.set_target_notch_frequency_weighted(100.0F, 1.0F);
+    filter.filter(0.0F);
+    filter.set_target_low_pass_frequency(50.0F);
+    for (int ii = 0; ii < 10; ++ii) {
+        filter.filter(0.0F);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, filter.get_weight());
+    // when not ramping the target weight is the current weight
+    filter.set_weight(0.25F);
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, filter.get_target_weight());
+}
+
+void test_biquad_filter_ramped_block()
+{
+    BiquadFilterRamped filter; // NOLINT(cppcoreguidelines-init-variables)
+    BiquadFilterRamped reference; // NOLINT(cppcoreguidelines-init-variables)
+    filter.init_lowpass(50.0F, 0.001F, 0.7071F);
+    reference.init_lowpass(50.0F, 0.001F, 0.7071F);
+    filter.set_ramp_samples(20);
+    reference.set_ramp_samples(20);
+    filter.set_target_low_pass_frequency(150.0F);
+    reference.set_target_low_pass_frequency(150.0F);
+
+    // block that covers the end of the ramp, filtered in place
+    std::array<float, 32> data {};
+    for (size_t ii = 0; ii < data.size(); ++ii) {
+        data[ii] = sinf(0.3F*static_cast<float>(ii)) + 0.5F;
+    }
+    const std::array<float, 32> input = data;
+    filter.filter_block(&data[0], 8);
+    filter.filter_block(&data[8], data.size() - 8);
+    for (size_t ii = 0; ii < data.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input[ii]), data[ii]);
+    }
+    TEST_ASSERT_FALSE(filter.is_ramping());
+    TEST_ASSERT_EQUAL_FLOAT(reference.get_parameters().a1, filter.get_parameters().a1);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
@@ -155,10 +580,20 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
 
     RUN_TEST(test_null_filter);
     RUN_TEST(test_moving_average_filter);
+    RUN_TEST(test_moving_average_filter_long_run);
+    RUN_TEST(test_multi_moving_average_filter);
     RUN_TEST(test_power_transfer_filter1);
     RUN_TEST(test_power_transfer_filter2);
     RUN_TEST(test_power_transfer_filter3);
+    RUN_TEST(test_power_transfer_filter_variable_dt);
     RUN_TEST(test_biquad_filter);
+    RUN_TEST(test_biquad_filter_block);
+    RUN_TEST(test_biquad_filter_ramped);
+    RUN_TEST(test_biquad_filter_ramped_retarget);
+    RUN_TEST(test_biquad_filter_ramped_block);
+    RUN_TEST(test_power_transfer_filter_advance);
+    RUN_TEST(test_biquad_filter_advance);
+    RUN_TEST(test_reset_to);
 
     UNITY_END();
 }
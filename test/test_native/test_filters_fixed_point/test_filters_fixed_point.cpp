@@ -0,0 +1,188 @@
+#include "filters_fixed_point.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+float test_input(size_t ii)
+{
+    const auto t = static_cast<float>(ii);
+    return 0.4F*sinf(0.0013F*t*static_cast<float>(ii % 7 + 1)) + 0.2F*sinf(0.9F*t);
+}
+
+//! Returns the maximum absolute difference between the float and fixed point filter outputs, for the same quantized input.
+template <typename Sample, typename FILTER, typename FILTER_Q>
+float max_error(FILTER& filter, FILTER_Q& filter_q)
+{
+    float error = 0.0F;
+    for (size_t ii = 0; ii < 20000; ++ii) {
+        const Sample input = FixedPoint<Sample>::from_float(test_input(ii));
+        const float output = filter.filter(FixedPoint<Sample>::to_float(input));
+        const float output_q = FixedPoint<Sample>::to_float(filter_q.filter(input));
+        error = std::max(error, fabsf(output - output_q));
+    }
+    return error;
+}
+} // end namespace
+
+void test_fixed_point_conversion()
+{
+    TEST_ASSERT_EQUAL(16384, FixedPoint<int16_t>::from_float(0.5F));
+    TEST_ASSERT_EQUAL(-32768, FixedPoint<int16_t>::from_float(-1.0F));
+    TEST_ASSERT_EQUAL(32767, FixedPoint<int16_t>::from_float(1.0F)); // saturated
+    TEST_ASSERT_EQUAL(32767, FixedPoint<int16_t>::from_float(3.0F));
+    TEST_ASSERT_EQUAL(INT32_MIN, FixedPoint<int32_t>::from_float(-2.0F));
+    TEST_ASSERT_EQUAL(INT32_MAX, FixedPoint<int32_t>::from_float(1.0F));
+    TEST_ASSERT_EQUAL(1073741824, FixedPoint<int32_t>::from_float(0.5F));
+    TEST_ASSERT_EQUAL_FLOAT(-0.25F, FixedPoint<int16_t>::to_float(-8192));
+    TEST_ASSERT_EQUAL(INT16_MAX, FixedPoint<int16_t>::saturate(100000));
+    TEST_ASSERT_EQUAL(INT16_MIN, FixedPoint<int16_t>::saturate(-100000));
+}
+
+void test_biquad_filter_q15_passthrough()
+{
+    BiquadFilterQ15 filter;
+    TEST_ASSERT_EQUAL(1000, filter.filter(1000));
+    TEST_ASSERT_EQUAL(-32768, filter.filter(-32768));
+    TEST_ASSERT_EQUAL(32767, filter.filter(32767));
+    std::array<int16_t, 3> data {{ 1, -2, 3 }};
+    filter.filter_block(&data[0], data.size());
+    TEST_ASSERT_EQUAL(-2, data[1]);
+}
+
+void test_biquad_filter_q15_error_bound()
+{
+    for (float frequency_hz : { 10.0F, 50.0F, 100.0F, 250.0F }) {
+        BiquadFilter filter;
+        filter.init_lowpass(frequency_hz, 0.001F, 0.7071F);
+        BiquadFilterQ15 filter_q;
+        filter_q.init_lowpass(frequency_hz, 0.001F, 0.7071F);
+        TEST_ASSERT_FLOAT_WITHIN(1e-8F, filter.get_parameters().a1, filter_q.get_parameters().a1);
+        const float bound = (frequency_hz < 50.0F ? 5.0F : 3.0F)/32768.0F;
+        TEST_ASSERT_TRUE(max_error<int16_t>(filter, filter_q) < bound);
+
+        filter.init_notch(frequency_hz, 0.001F, 2.0F);
+        filter_q.init_notch(frequency_hz, 0.001F, 2.0F);
+        TEST_ASSERT_TRUE(max_error<int16_t>(filter, filter_q) < bound);
+    }
+}
+
+void test_biquad_filter_q31_error_bound()
+{
+    for (float frequency_hz : { 10.0F, 50.0F, 100.0F, 250.0F }) {
+        BiquadFilter filter;
+        filter.init_lowpass(frequency_hz, 0.001F, 0.7071F);
+        BiquadFilterQ31 filter_q;
+        filter_q.init_lowpass(frequency_hz, 0.001F, 0.7071F);
+        TEST_ASSERT_TRUE(max_error<int32_t>(filter, filter_q) < 2e-5F);
+
+        filter.init_notch(frequency_hz, 0.001F, 2.0F);
+        filter_q.init_notch(frequency_hz, 0.001F, 2.0F);
+        TEST_ASSERT_TRUE(max_error<int32_t>(filter, filter_q) < 2e-5F);
+    }
+}
+
+void test_biquad_filter_q15_saturation()
+{
+    // a lightly damped lowpass overshoots a full scale step, the output saturates rather than wrapping
+    BiquadFilterQ15 filter;
+    filter.init_lowpass(100.0F, 0.001F, 5.0F);
+    int16_t output = 0;
+    int16_t min_output = 0;
+    for (size_t ii = 0; ii < 200; ++ii) {
+        output = filter.filter(ii < 100 ? 30000 : -30000);
+        min_output = std::min(min_output, output);
+    }
+    TEST_ASSERT_EQUAL(INT16_MIN, min_output);
+}
+
+void test_biquad_filter_q31_full_scale()
+{
+    // coefficients at the limits of their range, with the signs chosen so that all five products add, overflow a Q2.29 accumulator
+    BiquadFilterQ31 filter;
+    filter.set_parameters(-2.0F, -2.0F, 2.0F, 2.0F, 2.0F);
+    for (size_t ii = 0; ii < 4; ++ii) {
+        TEST_ASSERT_EQUAL(INT32_MAX, filter.filter(INT32_MAX));
+    }
+    filter.reset();
+    for (size_t ii = 0; ii < 4; ++ii) {
+        TEST_ASSERT_EQUAL(INT32_MIN, filter.filter(INT32_MIN));
+    }
+
+    // a narrow low frequency notch, where the sum of the absolute values of the coefficients is close to 7, passes
+    // a full scale square wave at the Nyquist frequency unchanged
+    BiquadFilter notch;
+    notch.init_notch(1.0F, 0.001F, 50.0F);
+    filter.init_notch(1.0F, 0.001F, 50.0F);
+    const biquad_coefficients_t c = filter.get_parameters();
+    TEST_ASSERT_TRUE(fabsf(c.a1) + fabsf(c.a2) + fabsf(c.b0) + fabsf(c.b1) + fabsf(c.b2) > 6.99F);
+    for (size_t ii = 0; ii < 1000; ++ii) {
+        const int32_t input = (ii & 1U) ? INT32_MIN : INT32_MAX;
+        // the float filter overshoots full scale slightly, the fixed point filter saturates
+        const float output = std::clamp(notch.filter(FixedPoint<int32_t>::to_float(input)), -1.0F, 1.0F);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, output, FixedPoint<int32_t>::to_float(filter.filter(input)));
+    }
+}
+
+void test_power_transfer_filter_q15()
+{
+    PowerTransferFilter1Q15 filter1(0.25F);
+    TEST_ASSERT_EQUAL(1 << 28, filter1.get_gain());
+    TEST_ASSERT_EQUAL(1000, filter1.filter(4000));
+    TEST_ASSERT_EQUAL(1750, filter1.filter(4000));
+
+    // with a low cutoff the filter converges to a step input, rather than stalling short of it
+    PowerTransferFilter1Q15 filter_slow(0.001F);
+    int16_t output = 0;
+    for (size_t ii = 0; ii < 20000; ++ii) {
+        output = filter_slow.filter(100);
+    }
+    TEST_ASSERT_EQUAL(100, output);
+
+    for (float k : { 0.001F, 0.01F, 0.1F, 1.0F }) {
+        PowerTransferFilter1 pt1(k);
+        PowerTransferFilter1Q15 pt1_q(k);
+        TEST_ASSERT_TRUE(max_error<int16_t>(pt1, pt1_q) <= 1.0F/32768.0F);
+        PowerTransferFilter2 pt2(k);
+        PowerTransferFilter2Q15 pt2_q(k);
+        TEST_ASSERT_TRUE(max_error<int16_t>(pt2, pt2_q) <= 1.0F/32768.0F);
+        PowerTransferFilter3 pt3(k);
+        PowerTransferFilter3Q15 pt3_q(k);
+        TEST_ASSERT_TRUE(max_error<int16_t>(pt3, pt3_q) <= 1.0F/32768.0F);
+    }
+}
+
+void test_power_transfer_filter_q31()
+{
+    PowerTransferFilter2Q31 filter(100.0F, 0.001F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9F, PowerTransferFilter2::gain_from_frequency(100.0F, 0.001F), static_cast<float>(filter.get_gain())/static_cast<float>(1 << 30));
+    for (float k : { 0.001F, 0.01F, 0.1F, 1.0F }) {
+        PowerTransferFilter3 pt3(k);
+        PowerTransferFilter3Q31 pt3_q(k);
+        TEST_ASSERT_TRUE(max_error<int32_t>(pt3, pt3_q) < 1e-6F);
+    }
+    filter.set_to_passthrough();
+    TEST_ASSERT_EQUAL(INT32_MIN, filter.filter(INT32_MIN));
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fixed_point_conversion);
+    RUN_TEST(test_biquad_filter_q15_passthrough);
+    RUN_TEST(test_biquad_filter_q15_error_bound);
+    RUN_TEST(test_biquad_filter_q31_error_bound);
+    RUN_TEST(test_biquad_filter_q31_full_scale);
+    RUN_TEST(test_biquad_filter_q15_saturation);
+    RUN_TEST(test_power_transfer_filter_q15);
+    RUN_TEST(test_power_transfer_filter_q31);
+
+    UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include "fir_filter.h"
+#include "rolling_buffer.h"
+#include <algorithm>
+#include <unity.h>
+#include <xyz_type.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+void test_fir_filter_passthrough()
+{
+    FIRFilter<8> filter;
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, filter.filter(1.0F));
+    TEST_ASSERT_EQUAL_FLOAT(-2.0F, filter.filter(-2.0F));
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, filter.filter_virtual(3.0F));
+}
+
+void test_fir_filter_moving_average()
+{
+    std::array<float, 3> coefficients {};
+    coefficients.fill(1.0F/3.0F);
+    FIRFilter<3> filter(coefficients);
+    FilterMovingAverage<3> moving_average;
+    moving_average.filter(0.0F);
+    moving_average.filter(0.0F);
+    for (size_t ii = 0; ii < 20; ++ii) {
+        const float input = static_cast<float>(ii*ii % 11);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, moving_average.filter(input), filter.filter(input));
+    }
+}
+
+void test_fir_filter_matches_convolution()
+{
+    constexpr size_t TAPS = 37; // not a multiple of the SIMD width
+    std::array<float, TAPS> coefficients {};
+    for (size_t ii = 0; ii < TAPS; ++ii) {
+        coefficients[ii] = static_cast<float>(ii + 1)/100.0F;
+    }
+    FIRFilter<TAPS> filter(coefficients);
+    RollingBuffer<float, TAPS> history;
+    for (size_t ii = 0; ii < TAPS; ++ii) {
+        history.push_back(0.0F);
+    }
+    std::array<float, 100> input {};
+    std::array<float, 100> output {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = sinf(0.37F*static_cast<float>(ii));
+    }
+    filter.filter_block(&input[0], &output[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        history.push_back(input[ii]);
+        float expected = 0.0F;
+        for (size_t k = 0; k < TAPS; ++k) {
+            expected += coefficients[k]*history[TAPS - 1 - k];
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected, output[ii]);
+    }
+
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(coefficients[0], filter.filter(1.0F));
+    TEST_ASSERT_EQUAL_FLOAT(coefficients[1], filter.filter(0.0F));
+}
+
+void test_fir_filter_block_small_taps()
+{
+    // small filters convolve blocks directly from the input, check against filter() across blocks shorter and longer than the filter, and in place
+    constexpr size_t TAPS = 7;
+    std::array<float, TAPS> coefficients {};
+    for (size_t ii = 0; ii < TAPS; ++ii) {
+        coefficients[ii] = static_cast<float>(ii + 1)/10.0F;
+    }
+    FIRFilter<TAPS> reference(coefficients);
+    FIRFilter<TAPS> filter(coefficients);
+    std::array<float, 64> data {};
+    size_t index = 0;
+    for (const size_t count : { 3U, 20U, 7U, 1U, 6U, 27U }) {
+        std::array<float, 27> input {};
+        std::array<float, 27> output {};
+        for (size_t ii = 0; ii < count; ++ii) {
+            input[ii] = sinf(0.37F*static_cast<float>(index + ii));
+            data[ii] = input[ii];
+        }
+        if (count % 2 == 0) {
+            filter.filter_block(&data[0], count);
+            std::copy(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(count), output.begin());
+        } else {
+            filter.filter_block(&input[0], &output[0], count);
+        }
+        for (size_t ii = 0; ii < count; ++ii) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(input[ii]), output[ii]);
+        }
+        index += count;
+    }
+    // the history is carried over to single samples
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, reference.filter(0.5F), filter.filter(0.5F));
+}
+
+void test_fir_filter_lowpass()
+{
+    FIRFilter<31> filter;
+    filter.init_lowpass(50.0F, 0.001F);
+    TEST_ASSERT_EQUAL_FLOAT(15.0F, filter.group_delay());
+    const auto& coefficients = filter.get_coefficients();
+    float sum = 0.0F;
+    for (size_t ii = 0; ii < 31; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-7F, coefficients[ii], coefficients[30 - ii]); // linear phase
+        sum += coefficients[ii];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 1.0F, sum);
+    float output = 0.0F;
+    for (size_t ii = 0; ii < 31; ++ii) {
+        output = filter.filter(2.0F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 2.0F, output);
+    // Nyquist frequency is heavily attenuated
+    for (size_t ii = 0; ii < 31; ++ii) {
+        output = filter.filter(ii % 2 == 0 ? 1.0F : -1.0F);
+    }
+    TEST_ASSERT_TRUE(fabsf(output) < 0.01F);
+}
+
+void test_fir_filter_xyz()
+{
+    FIRFilterT<xyz_t, 4> filter;
+    filter.set_coefficients({{ 0.5F, 0.25F, 0.125F, 0.125F }});
+    xyz_t output = filter.filter(xyz_t{8.0F, -8.0F, 16.0F});
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, output.x);
+    TEST_ASSERT_EQUAL_FLOAT(-4.0F, output.y);
+    TEST_ASSERT_EQUAL_FLOAT(8.0F, output.z);
+    output = filter.filter(xyz_t{0.0F, 0.0F, 0.0F});
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, output.x);
+    std::array<xyz_t, 3> data {{ {0.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 0.0F}, {8.0F, 8.0F, 8.0F} }};
+    filter.filter_block(&data[0], data.size());
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, data[0].x);
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, data[1].x);
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, data[2].x);
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fir_filter_passthrough);
+    RUN_TEST(test_fir_filter_moving_average);
+    RUN_TEST(test_fir_filter_matches_convolution);
+    RUN_TEST(test_fir_filter_block_small_taps);
+    RUN_TEST(test_fir_filter_lowpass);
+    RUN_TEST(test_fir_filter_xyz);
+
+    UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include "fir_filter_fft.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+template <size_t N>
+void check_real_fft_against_dft()
+{
+    const RealFFT<N> fft;
+    std::array<float, N> input {};
+    for (size_t ii = 0; ii < N; ++ii) {
+        input[ii] = sinf(0.7F*static_cast<float>(ii)) + static_cast<float>(ii % 5)*0.1F;
+    }
+    std::array<float, N> data = input;
+    std::array<float, N + 2> spectrum {};
+    fft.forward(data, spectrum);
+
+    for (size_t k = 0; k <= N/2; ++k) {
+        double re = 0.0;
+        double im = 0.0;
+        for (size_t n = 0; n < N; ++n) {
+            const double angle = 2.0*3.14159265358979323846*static_cast<double>(k*n)/static_cast<double>(N);
+            re += static_cast<double>(input[n])*cos(angle);
+            im -= static_cast<double>(input[n])*sin(angle);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(re), spectrum[2*k]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(im), spectrum[2*k + 1]);
+    }
+
+    fft.inverse(spectrum, data);
+    for (size_t ii = 0; ii < N; ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, input[ii], data[ii]/static_cast<float>(N));
+    }
+}
+} // end namespace
+
+void test_real_fft()
+{
+    check_real_fft_against_dft<4>();
+    check_real_fft_against_dft<8>();
+    check_real_fft_against_dft<16>(); // radix-2 stage followed by radix-4 stage
+    check_real_fft_against_dft<32>(); // radix-4 stages only
+    check_real_fft_against_dft<256>();
+}
+
+void test_fir_filter_fft_passthrough()
+{
+    static FIRFilterFFT<8> filter;
+    std::array<float, 50> data {};
+    for (size_t ii = 0; ii < data.size(); ++ii) {
+        data[ii] = static_cast<float>(ii);
+    }
+    filter.filter_block(&data[0], data.size());
+    for (size_t ii = 0; ii < data.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(ii), data[ii]);
+    }
+}
+
+void test_fir_filter_fft_matches_fir_filter()
+{
+    constexpr size_t TAPS = 100;
+    std::array<float, TAPS> coefficients {};
+    for (size_t ii = 0; ii < TAPS; ++ii) {
+        coefficients[ii] = sinf(static_cast<float>(ii)*0.3F)/static_cast<float>(ii + 5);
+    }
+    static FIRFilterFFT<TAPS> filter_fft(coefficients);
+    static_assert(FIRFilterFFT<TAPS>::CHUNK_SIZE == 512 - TAPS + 1);
+    FIRFilter<TAPS> filter(coefficients);
+
+    std::array<float, 2000> input {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = sinf(0.05F*static_cast<float>(ii)) + 0.5F*sinf(2.1F*static_cast<float>(ii));
+    }
+    std::array<float, 2000> expected {};
+    filter.filter_block(&input[0], &expected[0], input.size());
+
+    // irregular block sizes, including ones smaller than the history and larger than a chunk
+    std::array<float, 2000> output {};
+    const std::array<size_t, 6> counts {{ 1, 37, 413, 1000, 99, 450 }};
+    size_t position = 0;
+    for (size_t count : counts) {
+        filter_fft.filter_block(&input[position], &output[position], count);
+        position += count;
+    }
+    TEST_ASSERT_EQUAL(input.size(), position);
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, expected[ii], output[ii]);
+    }
+
+    // in-place, after reset
+    filter_fft.reset();
+    filter_fft.filter_block(&input[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-4F, expected[ii], input[ii]);
+    }
+}
+
+void test_fir_filter_fft_lowpass()
+{
+    static FIRFilterFFT<63, 128> filter;
+    filter.init_lowpass(50.0F, 0.001F);
+    TEST_ASSERT_EQUAL_FLOAT(31.0F, filter.group_delay());
+    std::array<float, 200> data {};
+    data.fill(3.0F);
+    filter.filter_block(&data[0], data.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, 3.0F, data[199]);
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_real_fft);
+    RUN_TEST(test_fir_filter_fft_passthrough);
+    RUN_TEST(test_fir_filter_fft_matches_fir_filter);
+    RUN_TEST(test_fir_filter_fft_lowpass);
+
+    UNITY_END();
+}
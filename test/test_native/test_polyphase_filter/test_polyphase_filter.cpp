@@ -0,0 +1,112 @@
+#include "polyphase_filter.h"
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+void test_fir_decimator_matches_fir_filter()
+{
+    constexpr size_t TAPS = 21;
+    constexpr size_t RATIO = 4;
+    FIRFilter<TAPS> filter;
+    filter.init_lowpass(1000.0F, 1.0F/32000.0F);
+    FIRDecimator<TAPS, RATIO> decimator(filter.get_coefficients());
+    static_assert(FIRDecimator<TAPS, RATIO>::ratio() == RATIO);
+    TEST_ASSERT_EQUAL_FLOAT(10.0F, decimator.latency());
+    TEST_ASSERT_EQUAL_FLOAT(2.5F, decimator.latency_output_samples());
+
+    std::array<float, 103> input {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = sinf(0.1F*static_cast<float>(ii)) + 0.3F*sinf(2.5F*static_cast<float>(ii));
+    }
+    std::array<float, 103> expected {};
+    filter.filter_block(&input[0], &expected[0], input.size());
+
+    // split the input at a point that is not a multiple of the ratio, to check partial phases are carried over
+    std::array<float, 30> output {};
+    size_t output_count = decimator.filter_block(&input[0], &output[0], 10);
+    TEST_ASSERT_EQUAL(2, output_count);
+    output_count += decimator.filter_block(&input[10], &output[output_count], input.size() - 10);
+    TEST_ASSERT_EQUAL(25, output_count);
+    for (size_t ii = 0; ii < output_count; ++ii) {
+        // output ii is the filter output at input sample (ii + 1)*RATIO - 1
+        TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected[(ii + 1)*RATIO - 1], output[ii]);
+    }
+}
+
+void test_fir_decimator_circular_buffer()
+{
+    FIRDecimator<8, 2> decimator;
+    decimator.set_coefficients({{ 0.5F, 0.5F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F }});
+    CircularBuffer<float, 16> buffer;
+    for (size_t ii = 0; ii < 7; ++ii) {
+        buffer.push_back(static_cast<float>(ii));
+    }
+    std::array<float, 8> output {};
+    TEST_ASSERT_EQUAL(3, decimator.filter_block(buffer, &output[0]));
+    TEST_ASSERT_TRUE(buffer.is_empty());
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, output[0]);
+    TEST_ASSERT_EQUAL_FLOAT(2.5F, output[1]);
+    TEST_ASSERT_EQUAL_FLOAT(4.5F, output[2]);
+    // sample 6 is pending, sample 7 completes the next output
+    float value = 0.0F;
+    TEST_ASSERT_TRUE(decimator.filter(7.0F, value));
+    TEST_ASSERT_EQUAL_FLOAT(6.5F, value);
+}
+
+void test_fir_interpolator_matches_zero_stuffing()
+{
+    constexpr size_t TAPS = 23; // not a multiple of the ratio
+    constexpr size_t RATIO = 4;
+    FIRFilter<TAPS> filter;
+    filter.init_lowpass(1000.0F, 1.0F/32000.0F);
+    FIRInterpolator<TAPS, RATIO> interpolator(filter.get_coefficients());
+    TEST_ASSERT_EQUAL(6, (FIRInterpolator<TAPS, RATIO>::PHASE_TAPS));
+
+    std::array<float, 30> input {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = sinf(0.3F*static_cast<float>(ii));
+    }
+    std::array<float, 30*RATIO> output {};
+    interpolator.filter_block(&input[0], &output[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        for (size_t phase = 0; phase < RATIO; ++phase) {
+            const float expected = filter.filter(phase == 0 ? input[ii]*static_cast<float>(RATIO) : 0.0F);
+            TEST_ASSERT_FLOAT_WITHIN(1e-5F, expected, output[ii*RATIO + phase]);
+        }
+    }
+}
+
+void test_fir_interpolator_dc_gain()
+{
+    FIRInterpolator<32, 4> interpolator;
+    interpolator.init_lowpass(500.0F, 1.0F/8000.0F);
+    TEST_ASSERT_EQUAL_FLOAT(15.5F, interpolator.latency());
+    CircularBuffer<float, 16> buffer;
+    std::array<float, 64> output {};
+    for (size_t ii = 0; ii < 16; ++ii) {
+        buffer.push_back(2.0F);
+    }
+    TEST_ASSERT_EQUAL(64, interpolator.filter_block(buffer, &output[0]));
+    for (size_t ii = 32; ii < output.size(); ++ii) {
+        // each phase subfilter has unity DC gain only approximately, the windowed-sinc filter is not a Nyquist filter
+        TEST_ASSERT_FLOAT_WITHIN(2e-3F, 2.0F, output[ii]);
+    }
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fir_decimator_matches_fir_filter);
+    RUN_TEST(test_fir_decimator_circular_buffer);
+    RUN_TEST(test_fir_interpolator_matches_zero_stuffing);
+    RUN_TEST(test_fir_interpolator_dc_gain);
+
+    UNITY_END();
+}
@@ -1,5 +1,12 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <rolling_buffer.h>
 #include <unity.h>
+#include <xyz_type.h>
+
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
 
 void setUp()
 {
@@ -410,6 +417,222 @@ void test_rolling_buffer_sum()
     TEST_ASSERT_EQUAL(62, rb.sum());
 }
 
+void test_rolling_buffer_sum_compensated()
+{
+    // a large item followed by small ones, the small items are lost by a plain float sum
+    static RollingBufferWithSum<float, 4, SumNeumaier<float>> rb;
+    rb.push_back(1.0e8F);
+    rb.push_back(1.0F);
+    rb.push_back(1.0F);
+    rb.push_back(1.0F);
+    rb.push_back(1.0F);
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, rb.sum());
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, rb.recalculate_sum());
+
+    static RollingBufferWithSum<float, 4> rb_plain;
+    rb_plain.push_back(1.0e8F);
+    rb_plain.push_back(1.0F);
+    rb_plain.push_back(1.0F);
+    rb_plain.push_back(1.0F);
+    rb_plain.push_back(1.0F);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, rb_plain.sum());
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, rb_plain.recalculate_sum());
+}
+
+void test_rolling_buffer_sum_integer()
+{
+    // the sum of int16_t items overflows int16_t, but is exact in the 64 bit accumulator
+    static RollingBufferWithSum<int16_t, 8, SumInteger<int16_t>> rb;
+    for (int ii = 0; ii < 100000; ++ii) {
+        rb.push_back(static_cast<int16_t>((ii % 2 == 0) ? 32767 : 32000 - (ii % 1000)));
+    }
+    int64_t expected = 0;
+    for (size_t ii = 0; ii < rb.size(); ++ii) {
+        expected += rb[ii];
+    }
+    TEST_ASSERT_TRUE(rb.sum() == expected);
+    TEST_ASSERT_TRUE(rb.recalculate_sum() == expected);
+
+    static RollingBufferWithSum<uint16_t, 3, SumInteger<uint16_t>> rb_unsigned;
+    rb_unsigned.push_back(65535);
+    rb_unsigned.push_back(65535);
+    rb_unsigned.push_back(2);
+    rb_unsigned.push_back(1);
+    TEST_ASSERT_TRUE(rb_unsigned.sum() == 65538U);
+}
+
+void test_rolling_min_max()
+{
+    static RollingMinMax<int, 4> rmm;
+    TEST_ASSERT_EQUAL(4, rmm.capacity());
+    TEST_ASSERT_TRUE(rmm.is_empty());
+
+    rmm.push_back(10);
+    TEST_ASSERT_EQUAL(1, rmm.size());
+    TEST_ASSERT_EQUAL(10, rmm.min());
+    TEST_ASSERT_EQUAL(10, rmm.max());
+    TEST_ASSERT_EQUAL(0, rmm.range());
+
+    rmm.push_back(5);
+    rmm.push_back(12);
+    rmm.push_back(7);
+    TEST_ASSERT_EQUAL(4, rmm.size());
+    TEST_ASSERT_EQUAL(5, rmm.min()); // {10, 5, 12, 7}
+    TEST_ASSERT_EQUAL(12, rmm.max());
+    TEST_ASSERT_EQUAL(7, rmm.range());
+
+    rmm.push_back(8);
+    TEST_ASSERT_EQUAL(4, rmm.size());
+    TEST_ASSERT_EQUAL(5, rmm.min()); // {5, 12, 7, 8}
+    TEST_ASSERT_EQUAL(12, rmm.max());
+
+    rmm.push_back(9);
+    TEST_ASSERT_EQUAL(7, rmm.min()); // {12, 7, 8, 9}, 5 has fallen off the front
+    TEST_ASSERT_EQUAL(12, rmm.max());
+
+    rmm.push_back(6);
+    TEST_ASSERT_EQUAL(6, rmm.min()); // {7, 8, 9, 6}, 12 has fallen off the front
+    TEST_ASSERT_EQUAL(9, rmm.max());
+    TEST_ASSERT_EQUAL(3, rmm.range());
+}
+
+namespace {
+template <size_t C>
+void check_rolling_min_max(uint32_t seed)
+{
+    // compare with scanning a RollingBuffer, including runs of equal values
+    RollingBuffer<float, C> rb;
+    RollingMinMax<float, C> rmm;
+    for (int ii = 0; ii < 500; ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        const auto value = static_cast<float>((seed >> 16U) % 20U);
+        rb.push_back(value);
+        rmm.push_back(value);
+        float min = rb[0];
+        float max = rb[0];
+        for (size_t jj = 1; jj < rb.size(); ++jj) {
+            min = std::min(min, rb[jj]);
+            max = std::max(max, rb[jj]);
+        }
+        TEST_ASSERT_EQUAL(rb.size(), rmm.size());
+        TEST_ASSERT_EQUAL_FLOAT(min, rmm.min());
+        TEST_ASSERT_EQUAL_FLOAT(max, rmm.max());
+        TEST_ASSERT_EQUAL_FLOAT(max - min, rmm.range());
+    }
+}
+} // end namespace
+
+void test_rolling_min_max_against_scan()
+{
+    check_rolling_min_max<1>(1);
+    check_rolling_min_max<2>(2);
+    check_rolling_min_max<7>(3);
+    check_rolling_min_max<32>(4);
+    // monotonic input, which fills the deques
+    RollingMinMax<int, 8> rmm;
+    for (int ii = 0; ii < 20; ++ii) {
+        rmm.push_back(ii);
+        TEST_ASSERT_EQUAL(std::max(0, ii - 7), rmm.min());
+        TEST_ASSERT_EQUAL(ii, rmm.max());
+    }
+    for (int ii = 20; ii > 0; --ii) {
+        rmm.push_back(ii);
+    }
+    TEST_ASSERT_EQUAL(1, rmm.min());
+    TEST_ASSERT_EQUAL(8, rmm.max());
+}
+
+void test_rolling_buffer_stats()
+{
+    static RollingBufferWithStats<float, 4> rb;
+    TEST_ASSERT_EQUAL(4, rb.capacity());
+    TEST_ASSERT_TRUE(rb.is_empty());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, rb.mean());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, rb.variance());
+
+    rb.push_back(2.0F);
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, rb.mean());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, rb.variance());
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, rb.rms());
+
+    rb.push_back(4.0F);
+    rb.push_back(4.0F);
+    rb.push_back(6.0F);
+    TEST_ASSERT_EQUAL(4, rb.size());
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, rb.mean()); // {2, 4, 4, 6}
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, rb.variance());
+    TEST_ASSERT_EQUAL_FLOAT(sqrtf(2.0F), rb.standard_deviation());
+    TEST_ASSERT_EQUAL_FLOAT(sqrtf(18.0F), rb.rms());
+
+    rb.push_back(-2.0F);
+    TEST_ASSERT_EQUAL(4, rb.size());
+    TEST_ASSERT_EQUAL_FLOAT(4.0F, rb[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0F, rb[3]);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0F, rb.back());
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, rb.mean()); // {4, 4, 6, -2}
+    TEST_ASSERT_EQUAL_FLOAT(9.0F, rb.variance());
+    TEST_ASSERT_EQUAL_FLOAT(3.0F, rb.standard_deviation());
+}
+
+void test_rolling_buffer_stats_long_run()
+{
+    // large offset and small variance, the case where a running sum of squares loses precision, over many times the capacity
+    static RollingBufferWithStats<float, 50> rb;
+    uint32_t seed = 3;
+    std::array<double, 50> window {};
+    for (size_t ii = 0; ii < 200000; ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        const float value = 1000.0F + 0.01F*static_cast<float>(ii % 1000) + static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U) - 0.5F;
+        rb.push_back(value);
+        window[ii % window.size()] = static_cast<double>(value);
+    }
+    double mean = 0.0;
+    for (const double value : window) {
+        mean += value;
+    }
+    mean /= static_cast<double>(window.size());
+    double variance = 0.0;
+    for (const double value : window) {
+        variance += (value - mean)*(value - mean);
+    }
+    variance /= static_cast<double>(window.size());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(mean), rb.mean());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F*static_cast<float>(variance), static_cast<float>(variance), rb.variance());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, static_cast<float>(sqrt(mean*mean + variance)), rb.rms());
+}
+
+void test_rolling_buffer_stats_xyz()
+{
+    static RollingBufferWithStats<xyz_t, 3> rb;
+    rb.push_back(xyz_t { 1.0F, 0.0F, -3.0F });
+    rb.push_back(xyz_t { 2.0F, 0.0F, 3.0F });
+    rb.push_back(xyz_t { 3.0F, 0.0F, -3.0F });
+    const xyz_t mean = rb.mean();
+    TEST_ASSERT_EQUAL_FLOAT(2.0F, mean.x);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, mean.y);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0F, mean.z);
+    const xyz_t variance = rb.variance();
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 2.0F/3.0F, variance.x);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, variance.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 8.0F, variance.z);
+    const xyz_t rms = rb.rms();
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, sqrtf(14.0F/3.0F), rms.x);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, rms.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 3.0F, rms.z);
+
+    // after many items the statistics match those of the last three items
+    for (int ii = 0; ii < 1000; ++ii) {
+        const auto t = static_cast<float>(ii);
+        rb.push_back(xyz_t { t, 100.0F + t, -t });
+    }
+    const xyz_t standard_deviation = rb.standard_deviation();
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, 998.0F, rb.mean().x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3F, 1098.0F, rb.mean().y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, sqrtf(2.0F/3.0F), standard_deviation.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, sqrtf(2.0F/3.0F), standard_deviation.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, sqrtf(2.0F/3.0F), standard_deviation.z);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
 
 int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
@@ -421,6 +644,13 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
     RUN_TEST(test_rolling_buffer_iteration);
     RUN_TEST(test_rolling_buffer_copy);
     RUN_TEST(test_rolling_buffer_sum);
+    RUN_TEST(test_rolling_buffer_sum_compensated);
+    RUN_TEST(test_rolling_buffer_sum_integer);
+    RUN_TEST(test_rolling_min_max);
+    RUN_TEST(test_rolling_min_max_against_scan);
+    RUN_TEST(test_rolling_buffer_stats);
+    RUN_TEST(test_rolling_buffer_stats_long_run);
+    RUN_TEST(test_rolling_buffer_stats_xyz);
 
     UNITY_END();
 }
\ No newline at end of file
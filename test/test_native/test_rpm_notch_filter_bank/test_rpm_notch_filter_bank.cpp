@@ -0,0 +1,132 @@
+#include "rpm_notch_filter_bank.h"
+#include <unity.h>
+#include <xyz_type.h>
+
+template <>
+struct FilterLaneTraits<xyz_t> : FilterVectorLaneTraits<xyz_t> {};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr float LOOPTIME = 0.000125F; // 8kHz
+constexpr float Q = 3.0F;
+constexpr float MIN_FREQUENCY = 100.0F;
+constexpr float FADE_RANGE = 50.0F;
+} // end namespace
+
+void test_rpm_notch_weights()
+{
+    RPMNotchFilterBank<xyz_t, 4, 3> bank;
+    bank.init(LOOPTIME, Q, MIN_FREQUENCY, FADE_RANGE);
+    // all notches disabled until the motor frequencies are set
+    for (size_t motor = 0; motor < 4; ++motor) {
+        for (size_t harmonic = 0; harmonic < 3; ++harmonic) {
+            TEST_ASSERT_EQUAL_FLOAT(0.0F, bank.get_weight(motor, harmonic));
+        }
+    }
+    bank.set_motor_frequencies({{ 50.0F, 125.0F, 400.0F, 1500.0F }});
+    // below the minimum frequency
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, bank.get_weight(0, 0));
+    // half way through the fade range
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, bank.get_weight(1, 0));
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, bank.get_weight(1, 2));
+    // fully enabled
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, bank.get_weight(2, 0));
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, bank.get_weight(2, 2));
+    // 3rd harmonic of 1500Hz is 4500Hz, above the Nyquist frequency
+    TEST_ASSERT_EQUAL_FLOAT(1.0F, bank.get_weight(3, 1));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, bank.get_weight(3, 2));
+    // 2nd harmonic of 1900Hz is 3800Hz, 40Hz below the maximum of 3840Hz
+    bank.set_motor_frequency(3, 1900.0F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, 0.8F, bank.get_weight(3, 1));
+}
+
+void test_rpm_notch_matches_biquad_filters()
+{
+    // the recurrence gives the same notches as calculating each harmonic directly
+    RPMNotchFilterBank<xyz_t, 2, 3> bank;
+    bank.init(LOOPTIME, Q, MIN_FREQUENCY, FADE_RANGE);
+    const std::array<float, 2> frequencies {{ 210.0F, 333.0F }};
+    bank.set_motor_frequencies<TrigLibm>(frequencies);
+
+    std::array<BiquadFilterT<xyz_t>, 6> notches {};
+    for (size_t motor = 0; motor < 2; ++motor) {
+        for (size_t harmonic = 0; harmonic < 3; ++harmonic) {
+            BiquadFilterT<xyz_t>& notch = notches[motor*3 + harmonic];
+            notch.set_looptime(LOOPTIME);
+            notch.set_q(Q);
+            notch.set_notch_frequency_weighted<TrigLibm>(frequencies[motor]*static_cast<float>(harmonic + 1), 1.0F);
+        }
+    }
+    for (size_t ii = 0; ii < 500; ++ii) {
+        const float t = static_cast<float>(ii);
+        const xyz_t input { sinf(0.1F*t), cosf(0.37F*t), 0.5F*sinf(0.9F*t) };
+        xyz_t expected = input;
+        for (auto& notch : notches) {
+            expected = notch.filter_weighted(expected);
+        }
+        const xyz_t output = bank.filter(input);
+        TEST_ASSERT_FLOAT_WITHIN(2e-4F, expected.x, output.x);
+        TEST_ASSERT_FLOAT_WITHIN(2e-4F, expected.y, output.y);
+        TEST_ASSERT_FLOAT_WITHIN(2e-4F, expected.z, output.z);
+    }
+}
+
+void test_rpm_notch_attenuation()
+{
+    RPMNotchFilterBank<xyz_t, 4, 3> bank;
+    bank.init(LOOPTIME, Q, MIN_FREQUENCY, FADE_RANGE);
+    bank.set_motor_frequencies({{ 180.0F, 190.0F, 200.0F, 210.0F }});
+
+    // 2nd harmonic of motor 2 on x, 3rd harmonic of motor 0 on y, and a low frequency signal on z, which passes through
+    constexpr float PI_F = 3.14159265358979323846F;
+    float max_x = 0.0F;
+    float max_y = 0.0F;
+    float max_z = 0.0F;
+    for (size_t ii = 0; ii < 8000; ++ii) {
+        const float t = static_cast<float>(ii)*LOOPTIME;
+        const xyz_t output = bank.filter({ sinf(2.0F*PI_F*400.0F*t), sinf(2.0F*PI_F*540.0F*t), sinf(2.0F*PI_F*10.0F*t) });
+        if (ii >= 4000) {
+            max_x = std::max(max_x, std::fabs(output.x));
+            max_y = std::max(max_y, std::fabs(output.y));
+            max_z = std::max(max_z, std::fabs(output.z));
+        }
+    }
+    TEST_ASSERT_TRUE(max_x < 0.01F);
+    TEST_ASSERT_TRUE(max_y < 0.01F);
+    TEST_ASSERT_FLOAT_WITHIN(0.02F, 1.0F, max_z);
+}
+
+void test_rpm_notch_stable_above_nyquist()
+{
+    // harmonics above the Nyquist frequency are disabled and do not make the filter unstable
+    RPMNotchFilterBank<float, 1, 4> bank;
+    bank.init(LOOPTIME, Q, MIN_FREQUENCY, FADE_RANGE);
+    bank.set_motor_frequency(0, 1700.0F);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, bank.get_weight(0, 2));
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, bank.get_weight(0, 3));
+    float max_output = 0.0F;
+    for (size_t ii = 0; ii < 10000; ++ii) {
+        max_output = std::max(max_output, std::fabs(bank.filter(ii == 0 ? 1.0F : 0.0F)));
+    }
+    TEST_ASSERT_TRUE(max_output < 2.0F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.0F, bank.filter(0.0F));
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rpm_notch_weights);
+    RUN_TEST(test_rpm_notch_matches_biquad_filters);
+    RUN_TEST(test_rpm_notch_attenuation);
+    RUN_TEST(test_rpm_notch_stable_above_nyquist);
+
+    UNITY_END();
+}
@@ -0,0 +1,169 @@
+#include "state_variable_filter.h"
+#include <cmath>
+#include <unity.h>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// NOLINTBEGIN(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+namespace {
+constexpr float LOOPTIME = 0.001F; // 1kHz
+constexpr float PI_F = 3.14159265358979323846F;
+
+//! amplitude of the output of `filter` for a sine wave input of frequency `frequency_hz`, measured from the RMS over a whole number of cycles after the filter has settled
+float amplitude(StateVariableFilter& filter, float frequency_hz)
+{
+    filter.reset();
+    float sum_squares = 0.0F;
+    for (int ii = 0; ii < 4000; ++ii) {
+        const float output = filter.filter(sinf(2.0F*PI_F*frequency_hz*LOOPTIME*static_cast<float>(ii)));
+        if (ii >= 3000) {
+            sum_squares += output*output;
+        }
+    }
+    return sqrtf(2.0F*sum_squares/1000.0F);
+}
+} // end namespace
+
+void test_state_variable_filter_tan_approximation()
+{
+    for (int ii = 0; ii <= 88; ++ii) {
+        const float x = 0.44F*PI_F*static_cast<float>(ii)/88.0F;
+        const float expected = tanf(x);
+        TEST_ASSERT_FLOAT_WITHIN(2e-5F*expected + 1e-7F, expected, StateVariableFilter::tan_approximation(x));
+    }
+    // less accurate close to the pole, but still monotonic
+    TEST_ASSERT_FLOAT_WITHIN(5e-4F*tanf(0.49F*PI_F), tanf(0.49F*PI_F), StateVariableFilter::tan_approximation(0.49F*PI_F));
+    TEST_ASSERT_GREATER_THAN_FLOAT(StateVariableFilter::tan_approximation(0.48F*PI_F), StateVariableFilter::tan_approximation(0.49F*PI_F));
+}
+
+void test_state_variable_filter_passthrough()
+{
+    StateVariableFilter filter;
+    // default constructed filter is passthrough
+    TEST_ASSERT_EQUAL_FLOAT(0.7F, filter.filter(0.7F));
+    TEST_ASSERT_EQUAL_FLOAT(-0.3F, filter.filter(-0.3F));
+
+    filter.init(100.0F, LOOPTIME, 0.7F, StateVariableFilter::NOTCH);
+    TEST_ASSERT_EQUAL(StateVariableFilter::NOTCH, filter.get_mode());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.7F, filter.get_q());
+    filter.filter(1.0F);
+    filter.set_to_passthrough();
+    TEST_ASSERT_EQUAL(StateVariableFilter::LOW_PASS, filter.get_mode());
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().ic1eq);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().ic2eq);
+    TEST_ASSERT_EQUAL_FLOAT(0.5F, filter.filter(0.5F));
+    TEST_ASSERT_EQUAL_FLOAT(0.25F, filter.filter_virtual(0.25F));
+}
+
+void test_state_variable_filter_matches_biquad_low_pass()
+{
+    // the lowpass output has the same transfer function as the BiquadFilter lowpass
+    constexpr float Q = 0.7071F;
+    StateVariableFilter svf(80.0F, LOOPTIME, Q, StateVariableFilter::LOW_PASS);
+    BiquadFilter biquad;
+    biquad.set_looptime(LOOPTIME);
+    biquad.set_q(Q);
+    biquad.set_low_pass_frequencyWeighted<TrigLibm>(80.0F, 1.0F);
+    biquad.reset();
+    for (int ii = 0; ii < 500; ++ii) {
+        const float input = (ii % 37 < 18 ? 1.0F : -1.0F) + 0.3F*sinf(0.9F*static_cast<float>(ii));
+        TEST_ASSERT_FLOAT_WITHIN(2e-4F, biquad.filter(input), svf.filter(input));
+    }
+}
+
+void test_state_variable_filter_responses()
+{
+    StateVariableFilter filter(100.0F, LOOPTIME, 2.0F, StateVariableFilter::LOW_PASS);
+    // unity DC gain
+    for (int ii = 0; ii < 2000; ++ii) {
+        filter.filter(1.0F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, 1.0F, filter.filter(1.0F));
+    // gain of q at the cutoff frequency, strong attenuation well above it
+    TEST_ASSERT_FLOAT_WITHIN(0.02F, 2.0F, amplitude(filter, 100.0F));
+    TEST_ASSERT_LESS_THAN_FLOAT(0.02F, amplitude(filter, 400.0F));
+
+    filter.set_mode(StateVariableFilter::BAND_PASS);
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 1.0F, amplitude(filter, 100.0F));
+    TEST_ASSERT_LESS_THAN_FLOAT(0.2F, amplitude(filter, 20.0F));
+    TEST_ASSERT_LESS_THAN_FLOAT(0.2F, amplitude(filter, 400.0F));
+
+    filter.set_mode(StateVariableFilter::HIGH_PASS);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01F, amplitude(filter, 5.0F));
+    TEST_ASSERT_FLOAT_WITHIN(0.05F, 1.0F, amplitude(filter, 450.0F));
+
+    filter.set_mode(StateVariableFilter::NOTCH);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01F, amplitude(filter, 100.0F));
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, 1.0F, amplitude(filter, 10.0F));
+    TEST_ASSERT_FLOAT_WITHIN(0.02F, 1.0F, amplitude(filter, 450.0F));
+
+    // the outputs are consistent: low + band*k + high = input
+    const StateVariableFilter::outputs_t outputs = filter.filter_all(0.8F);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 0.8F, outputs.low_pass + outputs.band_pass + outputs.high_pass);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5F, 0.8F, outputs.notch + outputs.band_pass);
+}
+
+void test_state_variable_filter_modulated_cutoff()
+{
+    // the cutoff is changed every sample, across almost the whole frequency range, and the output stays bounded
+    StateVariableFilter filter(100.0F, LOOPTIME, 5.0F, StateVariableFilter::LOW_PASS);
+    uint32_t seed = 12345;
+    float max_output = 0.0F;
+    for (int ii = 0; ii < 20000; ++ii) {
+        seed = seed*1664525U + 1013904223U;
+        const float frequency = 1.0F + 600.0F*static_cast<float>(seed >> 8U)/static_cast<float>(1U << 24U); // clamped above 490Hz
+        filter.set_cutoff_frequency(frequency);
+        const float output = filter.filter(ii % 50 < 25 ? 1.0F : -1.0F);
+        TEST_ASSERT_TRUE(std::isfinite(output));
+        max_output = std::max(max_output, std::fabs(output));
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(20.0F, max_output);
+
+    // returning to a fixed cutoff settles, with no residual transient
+    filter.set_cutoff_frequency(50.0F, LOOPTIME);
+    for (int ii = 0; ii < 2000; ++ii) {
+        filter.filter(0.5F);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4F, 0.5F, filter.filter(0.5F));
+}
+
+void test_state_variable_filter_block()
+{
+    StateVariableFilter filter(60.0F, LOOPTIME, 1.5F, StateVariableFilter::BAND_PASS);
+    StateVariableFilter reference(60.0F, LOOPTIME, 1.5F, StateVariableFilter::BAND_PASS);
+    std::array<float, 64> input {};
+    std::array<float, 64> output {};
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        input[ii] = sinf(0.3F*static_cast<float>(ii));
+    }
+    filter.filter_block(&input[0], &output[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter(input[ii]), output[ii]);
+    }
+    filter.filter_block(&input[0], input.size());
+    for (size_t ii = 0; ii < input.size(); ++ii) {
+        TEST_ASSERT_EQUAL_FLOAT(reference.filter(sinf(0.3F*static_cast<float>(ii))), input[ii]);
+    }
+    filter.set_cutoff_frequency_and_reset(60.0F, LOOPTIME);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().ic1eq);
+    TEST_ASSERT_EQUAL_FLOAT(0.0F, filter.get_state().ic2eq);
+}
+// NOLINTEND(cppcoreguidelines-init-variables,cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_state_variable_filter_tan_approximation);
+    RUN_TEST(test_state_variable_filter_passthrough);
+    RUN_TEST(test_state_variable_filter_matches_biquad_low_pass);
+    RUN_TEST(test_state_variable_filter_responses);
+    RUN_TEST(test_state_variable_filter_modulated_cutoff);
+    RUN_TEST(test_state_variable_filter_block);
+
+    UNITY_END();
+}